@@ -0,0 +1,128 @@
+#include "benchmark/benchmark.h"
+#include "wepp/http/httpParser.hpp"
+#include "wepp/priv/httpReceiver.hpp"
+#include <regex>
+
+using namespace Wepp;
+
+namespace
+{
+
+    const std::string g_request =
+        "GET /api/v1/users/12345/profile?fields=name,email HTTP/1.1\r\n"
+        "Host: localhost:8080\r\n"
+        "User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:60.0) Gecko/20100101 Firefox/60.0\r\n"
+        "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8\r\n"
+        "Accept-Language: en-US,en;q=0.5\r\n"
+        "Accept-Encoding: gzip, deflate\r\n"
+        "Cookie: session=0123456789abcdef0123456789abcdef; theme=dark\r\n"
+        "Connection: keep-alive\r\n"
+        "Cache-Control: max-age=0\r\n"
+        "\r\n";
+
+    // Request line and header parsing of the regex based receiver, kept as baseline.
+    bool regexParse(const char * data, const size_t size, Http::Request & request)
+    {
+        static const std::regex findRequestLineRegex(R"(^([^ ]*) (.*) ([^ ]*)$)");
+        static const std::regex findHeaderLineRegex(R"(^([^\:]*?)(\s*):(?:\s*)?(.*?)(?:\s*)?$)");
+
+        const char * end = data + size;
+        const char * line = data;
+        const char * lineEnd = std::search(line, end, "\r\n", "\r\n" + 2);
+        std::cmatch matches;
+        if (!std::regex_search(line, lineEnd, matches, findRequestLineRegex))
+        {
+            return false;
+        }
+        request.method(std::string(matches[1].first, matches[1].second));
+        request.resource(std::string(matches[2].first, matches[2].second));
+
+        line = lineEnd + 2;
+        while ((lineEnd = std::search(line, end, "\r\n", "\r\n" + 2)) != line)
+        {
+            if (lineEnd == end || !std::regex_search(line, lineEnd, matches, findHeaderLineRegex))
+            {
+                return false;
+            }
+            std::string fieldName = std::string(matches[1].first, matches[1].second);
+            std::transform(fieldName.begin(), fieldName.end(), fieldName.begin(), [](int c) -> char {return static_cast<char>(::tolower(c)); });
+            request.headers()[fieldName] = std::string(matches[3].first, matches[3].second);
+            line = lineEnd + 2;
+        }
+        return true;
+    }
+
+}
+
+static void BM_RegexParser(benchmark::State & state)
+{
+    for (auto _ : state)
+    {
+        Http::Request request;
+        if (!regexParse(g_request.c_str(), g_request.size(), request))
+        {
+            state.SkipWithError("Failed to parse request.");
+            break;
+        }
+        benchmark::DoNotOptimize(request);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(g_request.size()));
+}
+BENCHMARK(BM_RegexParser);
+
+static void BM_HttpParser(benchmark::State & state)
+{
+    Http::HttpParser parser;
+    for (auto _ : state)
+    {
+        Http::Request request;
+        parser.reset();
+
+        size_t position = 0;
+        Http::HttpParser::Result result;
+        do
+        {
+            size_t consumed = 0;
+            result = parser.execute(g_request.c_str() + position, g_request.size() - position, consumed, request);
+            position += consumed;
+        } while (result == Http::HttpParser::Result::RequestLine);
+
+        if (result != Http::HttpParser::Result::Complete)
+        {
+            state.SkipWithError("Failed to parse request.");
+            break;
+        }
+        benchmark::DoNotOptimize(request);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(g_request.size()));
+}
+BENCHMARK(BM_HttpParser);
+
+static void BM_HttpReceiver(benchmark::State & state)
+{
+    Priv::HttpReceiverBuffer buffer(16384);
+    Priv::HttpReceiver receiver;
+    Http::Response response;
+
+    for (auto _ : state)
+    {
+        Http::Request request;
+        buffer.reset();
+        buffer.receive(g_request);
+
+        if (receiver.parse(buffer, request, response, [](Http::Request &, Http::Response &) { return true; }) !=
+            Priv::HttpReceiver::Status::Ok)
+        {
+            state.SkipWithError("Failed to parse request.");
+            break;
+        }
+        benchmark::DoNotOptimize(request);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(g_request.size()));
+}
+BENCHMARK(BM_HttpReceiver);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,321 @@
+#include "benchmark/benchmark.h"
+#include "wepp/http/router.hpp"
+#include "wepp/http/staticRouter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+using namespace Wepp;
+
+namespace
+{
+
+    // Live bytes allocated through operator new, for measuring memory per route.
+    std::atomic<int64_t> g_allocatedBytes(0);
+    const size_t g_allocationHeader = 16;
+
+    // Route set of static, tagged and deep routes, with matching request paths.
+    struct RouteSet
+    {
+        std::vector<std::string> routes;
+        std::vector<std::string> paths;
+    };
+
+    RouteSet createRouteSet(const size_t count)
+    {
+        RouteSet routeSet;
+        routeSet.routes.reserve(count);
+        routeSet.paths.reserve(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const std::string id = std::to_string(i);
+            switch (i % 4)
+            {
+            case 0:
+                routeSet.routes.push_back("/static/" + id + "/index.html");
+                routeSet.paths.push_back("/static/" + id + "/index.html");
+                break;
+            case 1:
+                routeSet.routes.push_back("/user" + id + "/<id:int>/posts/<post:slug>");
+                routeSet.paths.push_back("/user" + id + "/12345/posts/hello-world");
+                break;
+            case 2:
+                routeSet.routes.push_back("/deep/a" + std::to_string(i % 10) + "/b" + std::to_string(i % 100) + "/c" + id + "/d/e/f/g");
+                routeSet.paths.push_back("/deep/a" + std::to_string(i % 10) + "/b" + std::to_string(i % 100) + "/c" + id + "/d/e/f/g");
+                break;
+            default:
+                routeSet.routes.push_back("/files" + id + "/<name:str>/<rest:path*>");
+                routeSet.paths.push_back("/files" + id + "/report/2018/q3.pdf");
+                break;
+            }
+        }
+
+        return routeSet;
+    }
+
+    const RouteSet & routeSet(const size_t count)
+    {
+        static std::map<size_t, RouteSet> routeSets;
+        auto it = routeSets.find(count);
+        if (it == routeSets.end())
+        {
+            it = routeSets.insert({ count, createRouteSet(count) }).first;
+        }
+        return it->second;
+    }
+
+    void registerRoutes(Http::Router & router, const RouteSet & routeSet)
+    {
+        auto & get = router[Http::Method::Get];
+        for (auto & route : routeSet.routes)
+        {
+            get[route] = [](const Http::Request &, Http::Response &) {};
+        }
+        router.publish();
+    }
+
+    // Request paths are visited in a fixed, scattered order, to not only measure the hottest routes.
+    std::vector<size_t> lookupOrder(const size_t count)
+    {
+        std::vector<size_t> order;
+        const size_t lookups = std::min<size_t>(count, 4096);
+        order.reserve(lookups);
+        for (size_t i = 0; i < lookups; i++)
+        {
+            order.push_back((i * 7919) % count);
+        }
+        return order;
+    }
+
+}
+
+void * operator new(size_t size)
+{
+    char * memory = static_cast<char *>(std::malloc(size + g_allocationHeader));
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    std::memcpy(memory, &size, sizeof(size));
+    g_allocatedBytes += static_cast<int64_t>(size);
+    return memory + g_allocationHeader;
+}
+
+void operator delete(void * pointer) noexcept
+{
+    if (pointer == nullptr)
+    {
+        return;
+    }
+    char * memory = static_cast<char *>(pointer) - g_allocationHeader;
+    size_t size = 0;
+    std::memcpy(&size, memory, sizeof(size));
+    g_allocatedBytes -= static_cast<int64_t>(size);
+    std::free(memory);
+}
+
+void operator delete(void * pointer, size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+static void BM_RouterRegister(benchmark::State & state)
+{
+    const RouteSet & routes = routeSet(static_cast<size_t>(state.range(0)));
+    int64_t bytes = 0;
+
+    for (auto _ : state)
+    {
+        const int64_t allocatedBefore = g_allocatedBytes;
+        {
+            Http::Router router;
+            registerRoutes(router, routes);
+            bytes = g_allocatedBytes - allocatedBefore;
+
+            state.PauseTiming();
+        }
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes_per_route"] = static_cast<double>(bytes) / static_cast<double>(state.range(0));
+}
+BENCHMARK(BM_RouterRegister)->Arg(10)->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static void BM_RouterFind(benchmark::State & state)
+{
+    const RouteSet & routes = routeSet(static_cast<size_t>(state.range(0)));
+    Http::Router router;
+    registerRoutes(router, routes);
+
+    const std::vector<size_t> order = lookupOrder(routes.paths.size());
+    std::vector<std::string> matches;
+    size_t index = 0;
+
+    for (auto _ : state)
+    {
+        const std::string & path = routes.paths[order[index]];
+        if (++index == order.size())
+        {
+            index = 0;
+        }
+
+        auto & callback = router.find("GET", path, matches);
+        if (callback == nullptr)
+        {
+            state.SkipWithError("Route not found.");
+            break;
+        }
+        benchmark::DoNotOptimize(callback);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RouterFind)->Arg(10)->Arg(1000)->Arg(100000);
+
+// Same routes and lookups as BM_RouterFind/10, fixed at build time, with routes of another method declared first.
+static void BM_StaticRouterFind(benchmark::State & state)
+{
+    const RouteSet & routes = routeSet(10);
+    int called = 0;
+    auto handler = [&called](const Http::Request &, Http::Response &) { called++; };
+    auto router = Http::makeStaticRouter(
+        Http::staticRoute(Http::Method::Post, "/static/0/index.html", handler),
+        Http::staticRoute(Http::Method::Post, "/user1/<id:int>/posts/<post:slug>", handler),
+        Http::staticRoute(Http::Method::Get, "/static/0/index.html", handler),
+        Http::staticRoute(Http::Method::Get, "/user1/<id:int>/posts/<post:slug>", handler),
+        Http::staticRoute(Http::Method::Get, "/deep/a2/b2/c2/d/e/f/g", handler),
+        Http::staticRoute(Http::Method::Get, "/files3/<name:str>/<rest:path*>", handler),
+        Http::staticRoute(Http::Method::Get, "/static/4/index.html", handler),
+        Http::staticRoute(Http::Method::Get, "/user5/<id:int>/posts/<post:slug>", handler),
+        Http::staticRoute(Http::Method::Get, "/deep/a6/b6/c6/d/e/f/g", handler),
+        Http::staticRoute(Http::Method::Get, "/files7/<name:str>/<rest:path*>", handler),
+        Http::staticRoute(Http::Method::Get, "/static/8/index.html", handler),
+        Http::staticRoute(Http::Method::Get, "/user9/<id:int>/posts/<post:slug>", handler));
+
+    const std::vector<size_t> order = lookupOrder(routes.paths.size());
+    Http::Request request;
+    Http::Response response;
+    Http::RouteCaptures captures;
+    size_t index = 0;
+
+    for (auto _ : state)
+    {
+        const std::string & path = routes.paths[order[index]];
+        if (++index == order.size())
+        {
+            index = 0;
+        }
+
+        const Http::RouteCallback * route = router.findRoute(Http::Method::Get, StringView(path), captures);
+        if (route == nullptr)
+        {
+            state.SkipWithError("Route not found.");
+            break;
+        }
+        router.call(route, request, response, captures);
+    }
+    benchmark::DoNotOptimize(called);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StaticRouterFind);
+
+static void BM_RouterFindCaptures(benchmark::State & state)
+{
+    const RouteSet & routes = routeSet(static_cast<size_t>(state.range(0)));
+    Http::Router router;
+    registerRoutes(router, routes);
+    auto snapshot = router.snapshot();
+
+    const std::vector<size_t> order = lookupOrder(routes.paths.size());
+    Http::RouteCaptures captures;
+    size_t index = 0;
+
+    for (auto _ : state)
+    {
+        const std::string & path = routes.paths[order[index]];
+        if (++index == order.size())
+        {
+            index = 0;
+        }
+
+        const Http::RouteCallback * route = snapshot->findRoute(Http::Method::Get, StringView(path), captures);
+        if (route == nullptr)
+        {
+            state.SkipWithError("Route not found.");
+            break;
+        }
+        benchmark::DoNotOptimize(route);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RouterFindCaptures)->Arg(10)->Arg(1000)->Arg(100000);
+
+static void BM_RouterFindMiss(benchmark::State & state)
+{
+    const RouteSet & routes = routeSet(static_cast<size_t>(state.range(0)));
+    Http::Router router;
+    registerRoutes(router, routes);
+    auto snapshot = router.snapshot();
+
+    const std::string path = "/static/unknown/index.html";
+    Http::RouteCaptures captures;
+
+    for (auto _ : state)
+    {
+        const Http::RouteCallback * route = snapshot->findRoute(Http::Method::Get, StringView(path), captures);
+        benchmark::DoNotOptimize(route);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RouterFindMiss)->Arg(10)->Arg(1000)->Arg(100000);
+
+// Snapshot read by every request of the server, from concurrent workers.
+static void BM_RouterSnapshot(benchmark::State & state)
+{
+    static Http::Router router;
+    if (state.thread_index() == 0)
+    {
+        registerRoutes(router, routeSet(10));
+    }
+
+    const std::string path = "/static/0/index.html";
+    Http::RouteCaptures captures;
+
+    for (auto _ : state)
+    {
+        const Http::RouteCallback * route = router.snapshot()->findRoute(Http::Method::Get, StringView(path), captures);
+        benchmark::DoNotOptimize(route);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RouterSnapshot)->ThreadRange(1, 8)->UseRealTime();
+
+// Results are written as JSON to wepp_bench_router.json, unless another output file is given.
+int main(int argc, char ** argv)
+{
+    std::vector<char *> arguments(argv, argv + argc);
+    bool hasOutput = false;
+    for (int i = 1; i < argc; i++)
+    {
+        hasOutput |= std::strncmp(argv[i], "--benchmark_out=", 16) == 0;
+    }
+
+    char outputArgument[] = "--benchmark_out=wepp_bench_router.json";
+    char formatArgument[] = "--benchmark_out_format=json";
+    if (!hasOutput)
+    {
+        arguments.push_back(outputArgument);
+        arguments.push_back(formatArgument);
+    }
+
+    int argumentCount = static_cast<int>(arguments.size());
+    benchmark::Initialize(&argumentCount, arguments.data());
+    if (benchmark::ReportUnrecognizedArguments(argumentCount, arguments.data()))
+    {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
@@ -29,7 +29,6 @@
 #include "wepp/build.hpp"
 #include <string>
 #include <vector>
-#include <algorithm>
 
 /**
 * Wepp namespace.
@@ -49,81 +48,171 @@ namespace Wepp
         * Http body class.
         *
         * The data is internally stored in a std::vector.
+        * If a spill threshold is set and exceeded, the data is moved to an unlinked temporary file,
+        * and data() returns a private memory mapping of the file. Linux only, bodies are kept in memory on other platforms.
         *
         */
-        class Body
+        class WEPP_API Body
         {
 
         public:
 
+            static const size_t maxRetainedCapacity = 64 * 1024; /**< Capacity kept by clear(). */
+
             /**
             * Default constructor.
             *
             */
-            Body()
-            { }
+            Body();
+
+            /**
+            * Copy constructor. The copy is kept in memory.
+            *
+            */
+            Body(const Body & body);
+
+            /**
+            * Move constructor. Takes over the memory or temporary file of body.
+            *
+            */
+            Body(Body && body) noexcept;
+
+            /**
+            * Destructor.
+            *
+            */
+            ~Body();
+
+            /**
+            * Copy assignment. The copy is kept in memory.
+            *
+            */
+            Body & operator =(const Body & body);
+
+            /**
+            * Move assignment. Takes over the memory or temporary file of body, closing the current file.
+            *
+            */
+            Body & operator =(Body && body) noexcept;
 
             /**
             * Gets data of body.
+            * Appending data invalidates the pointer.
+            *
+            * @return nullptr if a spilled body could not be mapped, marking the body as failed.
             *
             */
-            char * data()
-            {
-                return &m_data[0];
-            }
+            char * data();
 
             /**
             * Gets const data of body.
+            * Appending data invalidates the pointer.
+            *
+            * @return nullptr if a spilled body could not be mapped, marking the body as failed.
             *
             */
-            const char * data() const
-            {
-                return &m_data[0];
-            }
+            const char * data() const;
 
             /**
             * Gets size of body.
             *
             */
-            size_t size() const
-            {
-                return m_data.size();
-            }
+            size_t size() const;
+
+            /**
+            * Gets capacity of memory buffer, 0 if spilled.
+            *
+            */
+            size_t capacity() const;
+
+            /**
+            * Append data to body.
+            * If the data could not be written to the temporary file, the body is marked as failed.
+            * If the temporary file could not be created, the data is kept in memory, spilling is disabled until clear()
+            * and the body is marked as failed.
+            *
+            */
+            Body & append(const char * data, const size_t size);
 
             /**
-            * Append data to body
+            * Remove all data and failure state, keeping the spill threshold.
+            * Memory buffers above maxRetainedCapacity are released, smaller buffers are kept for reuse.
             *
             */
-            Body & append(const char * data, const size_t size)
-            {
-                std::copy(data, data + size, std::back_inserter<std::vector<char> >(m_data));
-                return *this;
-            }
+            void clear();
+
+            /**
+            * Set size in bytes above which the data is moved to a temporary file. 0 disables spilling, which is the default.
+            *
+            */
+            Body & spillThreshold(const size_t size);
+
+            /**
+            * Get size in bytes above which the data is moved to a temporary file.
+            *
+            */
+            size_t spillThreshold() const;
+
+            /**
+            * Checks if data is stored in a temporary file.
+            *
+            */
+            bool spilled() const;
+
+            /**
+            * Checks if data could not be written to or mapped from the temporary file.
+            *
+            */
+            bool failed() const;
 
             /**
             * Assigning operator.
             *
             */
-            Body & operator =(const std::string & string)
-            {
-                m_data.assign(string.begin(), string.end());
-                return *this;
-            }
+            Body & operator =(const std::string & string);
 
             /**
             * Input steaming operator.
             *
             */
-            Body & operator <<(const std::string & string)
-            {
-                std::copy(string.begin(), string.end(), std::back_inserter<std::vector<char> >(m_data));
-                return *this;
-            }
+            Body & operator <<(const std::string & string);
 
         private:
 
-            std::vector<char> m_data;     /**< Unique pointer for data.*/
-            //std::mutex m_mutex;           /**< Mutex protecting the data.*/
+            /**
+            * Move data to a temporary file.
+            *
+            * @return false if the file could not be created, keeping data in memory.
+            *
+            */
+            bool spill();
+
+            /**
+            * Write data to temporary file.
+            *
+            */
+            bool writeFile(const char * data, const size_t size);
+
+            /**
+            * Unmap and close temporary file.
+            *
+            */
+            void closeFile();
+
+            /**
+            * Unmap temporary file.
+            *
+            */
+            void unmap() const;
+
+            std::vector<char>   m_data;             /**< Data, if not spilled. */
+            size_t              m_spillThreshold;   /**< Size above which data is spilled, 0 if disabled. */
+            int                 m_file;             /**< Descriptor of temporary file, -1 if not spilled. */
+            size_t              m_fileSize;         /**< Size of data in temporary file. */
+            mutable char *      m_map;              /**< Mapping of temporary file, or nullptr. */
+            mutable size_t      m_mapSize;          /**< Size of mapping. */
+            bool                m_spillFailed;      /**< Temporary file could not be created, spilling is disabled. */
+            mutable bool        m_failed;           /**< Data could not be stored or mapped. */
 
         };
 
@@ -0,0 +1,158 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#ifndef WEPP_HTTP_CHUNKED_DECODER_HPP
+#define WEPP_HTTP_CHUNKED_DECODER_HPP
+
+#include "wepp/build.hpp"
+#include "wepp/http/status.hpp"
+#include "wepp/stringView.hpp"
+#include <cstdint>
+#include <limits>
+
+/**
+* Wepp namespace.
+*
+*/
+namespace Wepp
+{
+
+    /**
+    * Http namespace.
+    *
+    */
+    namespace Http
+    {
+
+        /**
+        * Incremental decoder of chunked transfer coding.
+        *
+        * Input may be split at any position, consumed bytes must not be passed again.
+        * Chunk data is returned as views into the input, nothing is copied.
+        * Chunk extensions and trailer fields are validated and ignored.
+        *
+        * @see https://tools.ietf.org/html/rfc7230#section-4.1
+        *
+        */
+        class WEPP_API ChunkedDecoder
+        {
+
+        public:
+
+            /**
+            * Enumerator of different return codes of execute().
+            *
+            */
+            enum class Result
+            {
+                NeedMore,   /**< All input is consumed, but the body is not complete. */
+                Data,       /**< Output chunk contains data. Call execute() again with the remaining input. */
+                Complete,   /**< The last chunk and trailer section have been decoded. */
+                Error       /**< The body is malformed or exceeds any limit, see error(). */
+            };
+
+            /**
+            * Constructor.
+            *
+            * @param[in] limitBodySize  - Maximum allowed size of decoded body. Default: no limit.
+            * @param[in] limitLine      - Maximum allowed length of chunk size and trailer lines. Default: 8192.
+            *
+            */
+            ChunkedDecoder(const uint64_t limitBodySize = std::numeric_limits<uint64_t>::max(), const size_t limitLine = 8192);
+
+            /**
+            * Reset the decoder state, before decoding a new body.
+            *
+            */
+            void reset();
+
+            /**
+            * Decode data.
+            *
+            * @param[in] data       - Pointer to first unconsumed byte.
+            * @param[in] size       - Number of available bytes.
+            * @param[out] consumed  - Number of consumed bytes.
+            * @param[out] chunk     - View of decoded data, if Data is returned.
+            *
+            */
+            Result execute(const char * data, const size_t size, size_t & consumed, StringView & chunk);
+
+            /**
+            * Get response status of the latest error.
+            *
+            */
+            Status error() const;
+
+            /**
+            * Get number of decoded body bytes.
+            *
+            */
+            uint64_t bodySize() const;
+
+        private:
+
+            /**
+            * Enumerator of decoder states.
+            *
+            */
+            enum class State : uint8_t
+            {
+                SizeStart,
+                Size,
+                Extension,
+                SizeLineEnd,
+                Data,
+                DataEnd,
+                DataLineEnd,
+                TrailerLineStart,
+                TrailerLine,
+                TrailerLineEnd,
+                LastLineEnd,
+                Complete,
+                Error
+            };
+
+            /**
+            * Set error state.
+            *
+            */
+            Result fail(const Status status);
+
+            const uint64_t  m_limitBodySize;    /**< Maximum size of decoded body. */
+            const size_t    m_limitLine;        /**< Maximum length of chunk size and trailer lines. */
+
+            State       m_state;                /**< Current state. */
+            Status      m_error;                /**< Status of latest error. */
+            uint64_t    m_chunkRemaining;       /**< Remaining data bytes of current chunk. */
+            uint64_t    m_bodySize;             /**< Number of decoded body bytes. */
+            size_t      m_lineLength;           /**< Length of current chunk size or trailer line. */
+
+        };
+
+    }
+
+}
+
+#endif
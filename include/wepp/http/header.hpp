@@ -0,0 +1,105 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#ifndef WEPP_HTTP_HEADER_HPP
+#define WEPP_HTTP_HEADER_HPP
+
+#include "wepp/build.hpp"
+#include "wepp/stringView.hpp"
+#include <string>
+#include <cstdint>
+
+/**
+* Wepp namespace.
+*
+*/
+namespace Wepp
+{
+
+    /**
+    * Http namespace.
+    *
+    */
+    namespace Http
+    {
+
+        /**
+        * Identifier of well-known header fields.
+        *
+        *
+        */
+        enum class HeaderId : uint8_t
+        {
+            Accept,
+            AcceptEncoding,
+            AcceptLanguage,
+            Authorization,
+            CacheControl,
+            Connection,
+            ContentEncoding,
+            ContentLength,
+            ContentType,
+            Cookie,
+            Date,
+            Expect,
+            Host,
+            IfModifiedSince,
+            IfNoneMatch,
+            LastModified,
+            Location,
+            Origin,
+            Range,
+            Referer,
+            Server,
+            SetCookie,
+            TransferEncoding,
+            Upgrade,
+            UserAgent,
+            XForwardedFor,
+
+            Unknown     /**< Not a well-known header field. Also number of well-known header fields. */
+        };
+
+        /**
+        * Get lowercase name of well-known header field.
+        *
+        * @return Name of header field, or empty string if id is Unknown.
+        *
+        */
+        WEPP_API const std::string & getHeaderAsString(const HeaderId id);
+
+        /**
+        * Get id of header field by name. Names are compared case insensitively.
+        *
+        * @return Id of header field, or HeaderId::Unknown if not well-known.
+        *
+        */
+        WEPP_API HeaderId getHeaderId(const StringView & name);
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,203 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#ifndef WEPP_HTTP_HEADER_MAP_HPP
+#define WEPP_HTTP_HEADER_MAP_HPP
+
+#include "wepp/build.hpp"
+#include "wepp/http/header.hpp"
+#include "wepp/stringView.hpp"
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+/**
+* Wepp namespace.
+*
+*/
+namespace Wepp
+{
+
+    /**
+    * Http namespace.
+    *
+    */
+    namespace Http
+    {
+
+        /**
+        * Flat container of header fields.
+        *
+        * Fields are stored contiguously in insertion order, duplicated names are allowed.
+        * Fields of well-known names are found in constant time by HeaderId, other names by a linear search.
+        * Names are compared case insensitively. Lookups return the last field of a duplicated name.
+        * Adding fields invalidates iterators and references, as for std::vector.
+        * Cleared and erased fields are kept, and reused by later fields without reallocating their strings.
+        *
+        */
+        template<typename String>
+        class BasicHeaderMap
+        {
+
+        public:
+
+            /**
+            * Header field. Member names are compatible with value_type of std::map.
+            *
+            */
+            struct Field
+            {
+                String      first;  /**< Name of field. Must not be modified in place. */
+                String      second; /**< Value of field. */
+                HeaderId    id;     /**< Id of name. */
+            };
+
+            typedef typename std::vector<Field>::iterator iterator;
+            typedef typename std::vector<Field>::const_iterator const_iterator;
+
+            /**
+            * Constructor.
+            *
+            */
+            BasicHeaderMap();
+
+            /**
+            * Get number of fields.
+            *
+            */
+            size_t size() const;
+
+            /**
+            * Checks if map is empty.
+            *
+            */
+            bool empty() const;
+
+            /**
+            * Remove all fields, keeping their memory for reuse.
+            *
+            */
+            void clear();
+
+            iterator begin();
+            iterator end();
+            const_iterator begin() const;
+            const_iterator end() const;
+
+            /**
+            * Find last field by name.
+            *
+            * @return Iterator of field, or end() if not found.
+            *
+            */
+            iterator find(const StringView & name);
+            const_iterator find(const StringView & name) const;
+
+            /**
+            * Find last field by id of well-known name, in constant time.
+            *
+            * @return Iterator of field, or end() if not found.
+            *
+            */
+            iterator find(const HeaderId id);
+            const_iterator find(const HeaderId id) const;
+
+            /**
+            * Add field, keeping any existing field of same name.
+            *
+            */
+            iterator add(const String & name, const String & value);
+
+            /**
+            * Add field with an already known id of name.
+            *
+            * @param[in] id - Id of name, as returned by getHeaderId(name).
+            *
+            */
+            iterator add(const HeaderId id, const String & name, const String & value);
+
+            /**
+            * Set value of last field by name, or add field if not found.
+            *
+            */
+            iterator set(const String & name, const String & value);
+
+            /**
+            * Add field if name is not found, similar to std::map::insert.
+            *
+            * @return Pair of iterator to field of name, and flag indicating if field was added.
+            *
+            */
+            std::pair<iterator, bool> insert(const std::pair<String, String> & field);
+
+            /**
+            * Get value of last field by name, adding an empty field if not found.
+            *
+            */
+            String & operator[](const String & name);
+
+            /**
+            * Remove all fields by name.
+            *
+            * @return Number of removed fields.
+            *
+            */
+            size_t erase(const StringView & name);
+
+        private:
+
+            static const size_t s_knownCount = static_cast<size_t>(HeaderId::Unknown);
+
+            /**
+            * Rebuild index of well-known fields.
+            *
+            */
+            void reindex();
+
+            std::vector<Field>  m_fields;               /**< Fields in insertion order, followed by cleared fields. */
+            size_t              m_size;                 /**< Number of used fields. */
+            uint32_t            m_index[s_knownCount];  /**< Position + 1 of last field of each well-known id, 0 if missing. */
+
+        };
+
+        /**
+        * Header map of owned strings.
+        *
+        */
+        typedef BasicHeaderMap<std::string> HeaderMap;
+
+        /**
+        * Header map of views.
+        *
+        */
+        typedef BasicHeaderMap<StringView> HeaderViewMap;
+
+    }
+
+}
+
+#include "wepp/http/headerMap.inl"
+
+#endif
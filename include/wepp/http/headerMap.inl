@@ -0,0 +1,245 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include <algorithm>
+#include <utility>
+
+namespace Wepp
+{
+
+    namespace Http
+    {
+
+        template<typename String>
+        BasicHeaderMap<String>::BasicHeaderMap() :
+            m_size(0),
+            m_index{}
+        { }
+
+        template<typename String>
+        size_t BasicHeaderMap<String>::size() const
+        {
+            return m_size;
+        }
+
+        template<typename String>
+        bool BasicHeaderMap<String>::empty() const
+        {
+            return m_size == 0;
+        }
+
+        template<typename String>
+        void BasicHeaderMap<String>::clear()
+        {
+            // Fields are kept, reusing the memory of their strings.
+            m_size = 0;
+            std::fill(m_index, m_index + s_knownCount, 0);
+        }
+
+        template<typename String>
+        typename BasicHeaderMap<String>::iterator BasicHeaderMap<String>::begin()
+        {
+            return m_fields.begin();
+        }
+
+        template<typename String>
+        typename BasicHeaderMap<String>::iterator BasicHeaderMap<String>::end()
+        {
+            return m_fields.begin() + static_cast<std::ptrdiff_t>(m_size);
+        }
+
+        template<typename String>
+        typename BasicHeaderMap<String>::const_iterator BasicHeaderMap<String>::begin() const
+        {
+            return m_fields.begin();
+        }
+
+        template<typename String>
+        typename BasicHeaderMap<String>::const_iterator BasicHeaderMap<String>::end() const
+        {
+            return m_fields.begin() + static_cast<std::ptrdiff_t>(m_size);
+        }
+
+        template<typename String>
+        typename BasicHeaderMap<String>::iterator BasicHeaderMap<String>::find(const StringView & name)
+        {
+            const HeaderId id = getHeaderId(name);
+            if (id != HeaderId::Unknown)
+            {
+                return find(id);
+            }
+
+            for (size_t i = m_size; i > 0; i--)
+            {
+                const Field & field = m_fields[i - 1];
+                if (field.id == HeaderId::Unknown && name.equalsIgnoreCase(field.first))
+                {
+                    return m_fields.begin() + static_cast<std::ptrdiff_t>(i - 1);
+                }
+            }
+
+            return end();
+        }
+
+        template<typename String>
+        typename BasicHeaderMap<String>::const_iterator BasicHeaderMap<String>::find(const StringView & name) const
+        {
+            return const_cast<BasicHeaderMap<String> *>(this)->find(name);
+        }
+
+        template<typename String>
+        typename BasicHeaderMap<String>::iterator BasicHeaderMap<String>::find(const HeaderId id)
+        {
+            if (id == HeaderId::Unknown || !m_index[static_cast<size_t>(id)])
+            {
+                return end();
+            }
+
+            return m_fields.begin() + static_cast<std::ptrdiff_t>(m_index[static_cast<size_t>(id)] - 1);
+        }
+
+        template<typename String>
+        typename BasicHeaderMap<String>::const_iterator BasicHeaderMap<String>::find(const HeaderId id) const
+        {
+            return const_cast<BasicHeaderMap<String> *>(this)->find(id);
+        }
+
+        template<typename String>
+        typename BasicHeaderMap<String>::iterator BasicHeaderMap<String>::add(const String & name, const String & value)
+        {
+            return add(getHeaderId(name), name, value);
+        }
+
+        template<typename String>
+        typename BasicHeaderMap<String>::iterator BasicHeaderMap<String>::add(const HeaderId id, const String & name, const String & value)
+        {
+            // Most requests fit, saving a few reallocations.
+            if (m_fields.capacity() == 0)
+            {
+                m_fields.reserve(16);
+            }
+
+            if (m_size < m_fields.size())
+            {
+                // Assign a cleared field, reusing the memory of its strings.
+                Field & field = m_fields[m_size];
+                field.first = name;
+                field.second = value;
+                field.id = id;
+            }
+            else
+            {
+                m_fields.push_back({ name, value, id });
+            }
+
+            m_size++;
+            if (id != HeaderId::Unknown)
+            {
+                m_index[static_cast<size_t>(id)] = static_cast<uint32_t>(m_size);
+            }
+
+            return end() - 1;
+        }
+
+        template<typename String>
+        typename BasicHeaderMap<String>::iterator BasicHeaderMap<String>::set(const String & name, const String & value)
+        {
+            auto it = find(name);
+            if (it == end())
+            {
+                return add(name, value);
+            }
+
+            it->second = value;
+            return it;
+        }
+
+        template<typename String>
+        std::pair<typename BasicHeaderMap<String>::iterator, bool> BasicHeaderMap<String>::insert(const std::pair<String, String> & field)
+        {
+            auto it = find(field.first);
+            if (it != end())
+            {
+                return { it, false };
+            }
+
+            return { add(field.first, field.second), true };
+        }
+
+        template<typename String>
+        String & BasicHeaderMap<String>::operator[](const String & name)
+        {
+            auto it = find(name);
+            if (it == end())
+            {
+                it = add(name, String());
+            }
+
+            return it->second;
+        }
+
+        template<typename String>
+        size_t BasicHeaderMap<String>::erase(const StringView & name)
+        {
+            // Removed fields are swapped behind the kept fields, and reused as cleared fields.
+            const size_t oldSize = m_size;
+            size_t kept = 0;
+            for (size_t i = 0; i < oldSize; i++)
+            {
+                if (!name.equalsIgnoreCase(m_fields[i].first))
+                {
+                    if (kept != i)
+                    {
+                        std::swap(m_fields[kept], m_fields[i]);
+                    }
+                    kept++;
+                }
+            }
+            m_size = kept;
+
+            if (m_size != oldSize)
+            {
+                reindex();
+            }
+
+            return oldSize - m_size;
+        }
+
+        template<typename String>
+        void BasicHeaderMap<String>::reindex()
+        {
+            std::fill(m_index, m_index + s_knownCount, 0);
+            for (size_t i = 0; i < m_size; i++)
+            {
+                if (m_fields[i].id != HeaderId::Unknown)
+                {
+                    m_index[static_cast<size_t>(m_fields[i].id)] = static_cast<uint32_t>(i + 1);
+                }
+            }
+        }
+
+    }
+
+}
@@ -0,0 +1,184 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#ifndef WEPP_HTTP_HTTP_PARSER_HPP
+#define WEPP_HTTP_HTTP_PARSER_HPP
+
+#include "wepp/build.hpp"
+#include "wepp/http/request.hpp"
+#include "wepp/http/status.hpp"
+#include <cstdint>
+
+/**
+* Wepp namespace.
+*
+*/
+namespace Wepp
+{
+
+    /**
+    * Http namespace.
+    *
+    */
+    namespace Http
+    {
+
+        /**
+        * Incremental http request parser.
+        *
+        * Parses the request line and header section using a character class table and vectorized scanning of control bytes,
+        * without any regex.
+        * Input may be split at any position. Only complete lines are consumed,
+        * the bytes of a partially received line must be passed again, together with the following bytes.
+        * Already scanned bytes of a partial line are not scanned again.
+        * Fields are stored in the request as views into the parsed data, see Request::materialize().
+        * The body is not handled by the parser, see contentLength() and chunked().
+        *
+        */
+        class WEPP_API HttpParser
+        {
+
+        public:
+
+            /**
+            * Enumerator of different return codes of execute().
+            *
+            */
+            enum class Result
+            {
+                NeedMore,       /**< All input is parsed, but the header section is not complete. */
+                RequestLine,    /**< The request line has been parsed. Call execute() again to parse the headers. */
+                Complete,       /**< The header section has been parsed. */
+                Error           /**< The request is malformed or exceeds any limit, see error(). */
+            };
+
+            /**
+            * Constructor.
+            *
+            * @param[in] limitRequestLine       - Maximum allowed length of request line. Default: 8192. Clamped: 16 minimum.
+            * @param[in] limitHeaderFieldLine   - Maximum allowed length of header line. Default: 8192. Clamped: 8 minimum.
+            * @param[in] limitHeaderFieldCount  - Maximum allowed numbers of header fields. Default: 512.
+            *
+            */
+            HttpParser(const size_t limitRequestLine = 8192, const size_t limitHeaderFieldLine = 8192,
+                       const size_t limitHeaderFieldCount = 512);
+
+            /**
+            * Reset the parser state, before parsing a new request.
+            *
+            */
+            void reset();
+
+            /**
+            * Parse data.
+            *
+            * @param[in] data       - Pointer to first unconsumed byte.
+            * @param[in] size       - Number of available bytes.
+            * @param[out] consumed  - Number of consumed bytes, belonging to completely parsed lines.
+            * @param[out] request   - Output data of request.
+            *
+            */
+            Result execute(const char * data, const size_t size, size_t & consumed, Request & request);
+
+            /**
+            * Get response status of the latest error.
+            *
+            */
+            Status error() const;
+
+            /**
+            * Get value of content-length header. 0 if missing.
+            *
+            */
+            size_t contentLength() const;
+
+            /**
+            * Checks if body is sent with chunked transfer coding, see ChunkedDecoder.
+            *
+            */
+            bool chunked() const;
+
+        private:
+
+            /**
+            * Enumerator of parser states.
+            *
+            */
+            enum class State : uint8_t
+            {
+                Method,
+                Resource,
+                Version,
+                RequestLineEnd,
+                HeaderLineStart,
+                HeaderName,
+                HeaderValueStart,
+                HeaderValue,
+                HeaderLineEnd,
+                HeadersEnd,
+                Complete,
+                Error
+            };
+
+            /**
+            * Set error state.
+            *
+            */
+            Result fail(const Status status);
+
+            /**
+            * Store the parsed request line in request.
+            *
+            */
+            bool commitRequestLine(const char * line, const size_t lineLength, Request & request);
+
+            /**
+            * Store the parsed header line in request.
+            *
+            */
+            bool commitHeader(const char * line, Request & request);
+
+            const size_t m_limitRequestLine;        /**< Maximum length of request line. */
+            const size_t m_limitHeaderFieldLine;    /**< Maximum length of header line. */
+            const size_t m_limitHeaderFieldCount;   /**< Maximum number of header fields. */
+
+            State   m_state;                        /**< Current state. */
+            Status  m_error;                        /**< Status of latest error. */
+            size_t  m_position;                     /**< Number of scanned bytes of current line. */
+            size_t  m_tokenEnd;                     /**< End of method or header name, relative to line. */
+            size_t  m_valueStart;                   /**< Start of version or header value, relative to line. */
+            size_t  m_valueEnd;                     /**< End of resource or header value, relative to line. */
+            size_t  m_headerCount;                  /**< Number of parsed header fields. */
+            size_t  m_contentLength;                /**< Value of content-length header. */
+            bool    m_foundContentLength;           /**< Flag, indicating if a content-length header is found. */
+            bool    m_chunked;                      /**< Flag, indicating if transfer-encoding is chunked. */
+
+        };
+
+    }
+
+}
+
+#endif
@@ -27,6 +27,7 @@
 #define WEPP_HTTP_METHOD_HPP
 
 #include "wepp/build.hpp"
+#include "wepp/stringView.hpp"
 #include <string>
 
 /**
@@ -58,17 +59,29 @@ namespace Wepp
             Trace,
             Option,
             Connect,
-            Patch
+            Patch,
+            Custom      /**< Any other method, identified by name. Also the number of named methods. */
         };
 
         /**
         * Get name of method as string.
         *
-        * @return Name of method given as parameter.
+        * @return Name of method given as parameter, or empty string for Method::Custom.
         *
         */
         WEPP_API const std::string & getMethodAsString(const Method method);
 
+        /**
+        * Get method by name, using a perfect hash of the first two bytes of name. Names are case sensitive.
+        *
+        * @param[in] name - Name of method.
+        * @param[out] method - Found method.
+        *
+        * @return true if found, else false.
+        *
+        */
+        WEPP_API bool parseMethod(const StringView & name, Method & method);
+
     }
 
 }
@@ -28,8 +28,9 @@
 
 #include "wepp/build.hpp"
 #include "wepp/http/body.hpp"
+#include "wepp/http/headerMap.hpp"
+#include "wepp/stringView.hpp"
 #include <string>
-#include <map>
 
 /**
 * Wepp namespace.
@@ -48,6 +49,10 @@ namespace Wepp
         /**
         * Http request class.
         *
+        * Fields may be views into memory owned by someone else, typically the receive buffer of the connection.
+        * Owned copies are made on demand, by the accessors returning std::string or HeaderMap,
+        * while the view accessors never copy.
+        *
         */
         class WEPP_API Request
         {
@@ -58,7 +63,7 @@ namespace Wepp
             * Header map type.
             *
             */
-            typedef std::map<std::string, std::string> HeaderMap;
+            typedef Http::HeaderMap HeaderMap;
 
             /**
             * Default constructor.
@@ -108,6 +113,54 @@ namespace Wepp
             */
             Body & body();
 
+            /**
+            * Get method, without copying.
+            * A method set as view is not converted to uppercase.
+            *
+            */
+            StringView methodView() const;
+
+            /**
+            * Get resource, without copying.
+            *
+            */
+            StringView resourceView() const;
+
+            /**
+            * Get version, without copying.
+            *
+            */
+            StringView versionView() const;
+
+            /**
+            * Find value of header field, without copying.
+            * Names are compared case insensitively. The last field is returned if present multiple times.
+            *
+            * @return Value of header field, or empty view if not found.
+            *
+            */
+            StringView header(const StringView & name) const;
+
+            /**
+            * Find value of well-known header field in constant time, without copying.
+            *
+            * @return Value of header field, or empty view if not found.
+            *
+            */
+            StringView header(const HeaderId id) const;
+
+            /**
+            * Checks if header field is present.
+            *
+            */
+            bool hasHeader(const StringView & name) const;
+
+            /**
+            * Checks if well-known header field is present.
+            *
+            */
+            bool hasHeader(const HeaderId id) const;
+
             /**
             * Set method.
             * 
@@ -128,14 +181,70 @@ namespace Wepp
             */
             Request & version(const std::string & version);
 
-        private:
+            /**
+            * Set method as view. Referenced memory must outlive the view, or materialize() must be called first.
+            *
+            */
+            Request & methodView(const StringView & method);
+
+            /**
+            * Set resource as view. Referenced memory must outlive the view, or materialize() must be called first.
+            *
+            */
+            Request & resourceView(const StringView & resource);
+
+            /**
+            * Set version as view. Referenced memory must outlive the view, or materialize() must be called first.
+            *
+            */
+            Request & versionView(const StringView & version);
+
+            /**
+            * Add header field as view. Referenced memory must outlive the view, or materialize() must be called first.
+            *
+            */
+            Request & addHeaderView(const StringView & name, const StringView & value);
+
+            /**
+            * Add header field as view, with an already known id of name.
+            *
+            */
+            Request & addHeaderView(const HeaderId id, const StringView & name, const StringView & value);
 
-            std::string m_method;       /**< Request method. */
-            std::string m_resource;     /**< Request URI/resource. */
-            std::string m_version;      /**< Version of HTTP protocol. */
+            /**
+            * Make owned copies of all fields set as views.
+            *
+            */
+            void materialize() const;
+
+            /**
+            * Reset request to the state of a default constructed request,
+            * keeping the memory of strings, header fields and body for the next request. Bodies above Body::maxRetainedCapacity are released.
+            *
+            */
+            void reset();
+
+        private:
 
-            HeaderMap m_headers;        /**< Headers map. */
-            Body m_body;                /**< Request body. */
+            void materializeMethod() const;
+            void materializeResource() const;
+            void materializeVersion() const;
+            void materializeHeaders() const;
+
+            mutable std::string m_method;       /**< Request method. */
+            mutable std::string m_resource;     /**< Request URI/resource. */
+            mutable std::string m_version;      /**< Version of HTTP protocol. */
+
+            mutable HeaderMap m_headers;        /**< Headers map. */
+            Body m_body;                        /**< Request body. */
+
+            StringView m_methodView;            /**< View of method, if not owned. */
+            StringView m_resourceView;          /**< View of resource, if not owned. */
+            StringView m_versionView;           /**< View of version, if not owned. */
+            mutable HeaderViewMap m_headerViews; /**< Header fields not yet copied to the headers map. */
+            mutable bool m_methodOwned;         /**< Flag, indicating if method is owned. */
+            mutable bool m_resourceOwned;       /**< Flag, indicating if resource is owned. */
+            mutable bool m_versionOwned;        /**< Flag, indicating if version is owned. */
 
         };
 
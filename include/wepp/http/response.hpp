@@ -29,6 +29,7 @@
 #include "wepp/build.hpp"
 #include "wepp/http/status.hpp"
 #include "wepp/http/body.hpp"
+#include "wepp/http/headerMap.hpp"
 
 /**
 * Wepp namespace.
@@ -71,6 +72,34 @@ namespace Wepp
             */
             Response & status(const Status status);
 
+            /**
+            * Get headers.
+            * Content-Length and Connection are set by the server, and not sent if set here.
+            *
+            */
+            HeaderMap & headers();
+
+            /**
+            * Get const headers.
+            *
+            */
+            const HeaderMap & headers() const;
+
+            /**
+            * Set header field, replacing the value of any existing field of same name.
+            *
+            */
+            Response & header(const std::string & name, const std::string & value);
+
+            /**
+            * Set well-known header field by id, replacing the value of any existing field.
+            * The name is not looked up, and the memory of a replaced value is reused.
+            *
+            * @param[in] id - Id of field, sent by its lowercase name. Ignored if HeaderId::Unknown.
+            *
+            */
+            Response & header(const HeaderId id, const StringView & value);
+
             /**
             * Get body.
             *
@@ -89,10 +118,18 @@ namespace Wepp
             */
             Response & operator <<(const std::string & string);
 
+            /**
+            * Reset response to the state of a default constructed response,
+            * keeping the memory of header fields and body for the next response. Bodies above Body::maxRetainedCapacity are released.
+            *
+            */
+            void reset();
+
         private:
 
-            Status  m_status;   /**< Status of response. */
-            Body    m_body;     /**< Body of response. */
+            Status      m_status;   /**< Status of response. */
+            HeaderMap   m_headers;  /**< Headers of response. */
+            Body        m_body;     /**< Body of response. */
 
         };
 
@@ -34,6 +34,9 @@
 #include <map>
 #include <functional>
 #include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
 
 /**
 * Wepp namespace.
@@ -51,10 +54,172 @@ namespace Wepp
 
         class RouteMethod;
         class RouteCallback;
+        class RouteCaptures;
+        class RouteTrie;
+
+        /**
+        * Parameter captured by a tag of a routed path.
+        *
+        * Typed tags are matched by built-in scanners, without regex:
+        *   <int>, <name:int>   - Signed decimal integer, fitting in int64_t.
+        *   <uuid>, <name:uuid> - UUID of hexadecimal digits, formatted as 8-4-4-4-12.
+        *   <slug>, <name:slug> - Letters, digits, '-' and '_'.
+        *   <str>, <name:str>   - Any directory, same as <>.
+        *   <path*>, <name:path*> - Rest of path, including slashes. Must be the whole last directory.
+        * Any other tag is treated as a regex.
+        *
+        */
+        struct WEPP_API RouteParameter
+        {
+
+            /**
+            * Enumerator of parameter types.
+            *
+            */
+            enum class Type : uint8_t
+            {
+                Regex,
+                String,
+                Int,
+                Uuid,
+                Slug,
+                Path
+            };
+
+            std::string name;   /**< Name of tag, empty if unnamed. */
+            Type type;          /**< Type of tag. */
+            std::string value;  /**< Matched text. */
+            int64_t integer;    /**< Converted value of Int parameters, else 0. */
+
+        };
+
+        /**
+        * Fixed capacity array of parameters captured by the tags of a routed path, without heap allocations.
+        * Values are views into the path, and names are views into the route tree.
+        * Captures beyond the capacity are dropped.
+        *
+        */
+        class WEPP_API RouteCaptures
+        {
+
+        public:
+
+            static const size_t capacity = 16;  /**< Maximum number of captures. */
+            static const size_t npos = static_cast<size_t>(-1);
+
+            /**
+            * Constructor.
+            *
+            */
+            RouteCaptures();
+
+            /**
+            * Get number of captures.
+            *
+            */
+            size_t size() const;
+
+            /**
+            * Checks if there are no captures.
+            *
+            */
+            bool empty() const;
+
+            /**
+            * Get value of capture by index.
+            *
+            */
+            StringView operator[](const size_t index) const;
+
+            /**
+            * Get name of capture by index, empty if unnamed.
+            *
+            */
+            StringView name(const size_t index) const;
+
+            /**
+            * Get type of capture by index.
+            *
+            */
+            RouteParameter::Type type(const size_t index) const;
+
+            /**
+            * Get converted value of Int capture by index, else 0.
+            *
+            */
+            int64_t integer(const size_t index) const;
+
+            /**
+            * Find index of capture by name.
+            *
+            * @return Index of first capture with name, or npos if not found.
+            *
+            */
+            size_t find(const StringView & name) const;
+
+            /**
+            * Get value of capture by name, or empty view if not found.
+            *
+            */
+            StringView value(const StringView & name) const;
+
+            /**
+            * Get converted value of Int capture by name.
+            *
+            * @return Converted value, or defaultValue if not found.
+            *
+            */
+            int64_t integer(const StringView & name, const int64_t defaultValue = 0) const;
+
+            /**
+            * Remove all captures, starting to capture from path.
+            *
+            */
+            void reset(const char * path = nullptr);
+
+            /**
+            * Add capture, located within path.
+            *
+            * @return false if the capacity is reached, else true.
+            *
+            */
+            bool add(const StringView & name, const RouteParameter::Type type, const char * begin, const char * end, const int64_t integer);
+
+            /**
+            * Move captures to a copy of the path, keeping their positions within it.
+            *
+            */
+            void rebase(const char * path);
+
+        private:
+
+            /**
+            * Structure describing a capture, relative to the path.
+            *
+            */
+            struct Entry
+            {
+                StringView name;
+                size_t offset;
+                size_t size;
+                int64_t integer;
+                RouteParameter::Type type;
+            };
+
+            Entry m_entries[capacity];  /**< Captures. */
+            size_t m_size;              /**< Number of captures. */
+            const char * m_path;        /**< Path of captures. */
+
+        };
 
         /**
         * Http routing class.
         *
+        * Known methods are indexed by their enumerator, parsed from method names by perfect hash, while custom methods are mapped by name.
+        * Routes are changed by a single writer, and published as an immutable snapshot with publish().
+        * Readers, typically server workers, get an owning reference to the latest published snapshot without waiting for the writer:
+        * each thread remembers its last snapshot without keeping it alive, and only refreshes it under a lock once a new version is published.
+        * The snapshot is kept alive for as long as it is referenced.
         *
         */
         class WEPP_API Router
@@ -62,12 +227,76 @@ namespace Wepp
 
         public:
 
+            /**
+            * Immutable snapshot of published routes.
+            *
+            */
+            class WEPP_API Snapshot
+            {
+
+            public:
+
+                /**
+                * Find route by method and path, capturing parameters as views into path.
+                * The returned route is valid for the lifetime of the snapshot.
+                *
+                * @param[in] method - Method to find in route tree.
+                * @param[in] path - Path to find in route tree.
+                * @param[out] captures - Matching parameters.
+                *
+                * @return Found route, or nullptr if not found.
+                *
+                */
+                const RouteCallback * findRoute(const StringView & method, const StringView & path, RouteCaptures & captures) const;
+
+                /**
+                * Find route by already parsed method and path, capturing parameters as views into path.
+                * Custom methods are found by name only.
+                *
+                */
+                const RouteCallback * findRoute(const Method method, const StringView & path, RouteCaptures & captures) const;
+
+            private:
+
+                friend class Router;
+
+                std::shared_ptr<const RouteTrie> m_methods[static_cast<size_t>(Method::Custom)];        /**< Compiled tries of methods, by enumerator. */
+                std::map<std::string, std::shared_ptr<const RouteTrie>> m_customMethods;                /**< Compiled tries of custom methods, by name. */
+
+            };
+
             /**
             * Callback function, called when successfully routed.
             *
             */
             typedef std::function<void(const Request &, Response &)> CallbackFunc;
 
+            /**
+            * Callback function, called when successfully routed, receiving the captured parameters.
+            *
+            */
+            typedef std::function<void(const Request &, Response &, const RouteCaptures &)> CaptureCallbackFunc;
+
+            /**
+            * Body data function, called for each received slice of the request body, instead of buffering it in Request::body().
+            * The slice is only valid during the call. No more data is received until the function returns,
+            * letting TCP flow control throttle the client. Return false to abort the request.
+            *
+            */
+            typedef std::function<bool(const Request &, Response &, const StringView &)> DataFunc;
+
+            /**
+            * Statistics of lookup cache.
+            *
+            */
+            struct WEPP_API CacheStatistics
+            {
+                uint64_t hits;      /**< Number of lookups found in cache. */
+                uint64_t misses;    /**< Number of lookups not found in cache. */
+                uint64_t evictions; /**< Number of entries evicted to make room for new ones. */
+                size_t size;        /**< Number of cached entries. */
+            };
+
             /**
             * Constuctor.
             *
@@ -91,6 +320,8 @@ namespace Wepp
             *
             * @param[in] method - Enumerator representing method.
             *
+            * @throw std::invalid_argument if method is Method::Custom, custom methods are routed by name.
+            *
             */
             RouteMethod & operator[](const Method method);
 
@@ -109,11 +340,89 @@ namespace Wepp
             * @param[in] path - Path to find in route tree.
             * @param[out] tags - Vector of matching tags.
             *
-            * @return Found function.
+            * @return Found function. Routes assigned a CaptureCallbackFunc are found by findRoute.
             *
             */
             const Router::CallbackFunc & find(const std::string & method, const std::string & path, std::vector<std::string> & matches) const;
 
+            /**
+            * Find route by method and path.
+            *
+            * @param[in] method - Method to find in route tree.
+            * @param[in] path - Path to find in route tree.
+            * @param[out] tags - Vector of matching tags.
+            *
+            * @return Found route, or nullptr if not found.
+            *
+            */
+            const RouteCallback * findRoute(const std::string & method, const std::string & path, std::vector<std::string> & matches) const;
+
+            /**
+            * Find route by method and path, capturing typed parameters.
+            *
+            * @param[in] method - Method to find in route tree.
+            * @param[in] path - Path to find in route tree.
+            * @param[out] parameters - Vector of matching parameters.
+            *
+            * @return Found route, or nullptr if not found.
+            *
+            */
+            const RouteCallback * findRoute(const std::string & method, const std::string & path, std::vector<RouteParameter> & parameters) const;
+
+            /**
+            * Find route by method and path, capturing parameters as views into path.
+            *
+            * @param[in] method - Method to find in route tree.
+            * @param[in] path - Path to find in route tree.
+            * @param[out] captures - Matching parameters.
+            *
+            * @return Found route, or nullptr if not found.
+            *
+            */
+            const RouteCallback * findRoute(const std::string & method, const StringView & path, RouteCaptures & captures) const;
+
+            /**
+            * Set capacity of lookup cache, per method. The cache is disabled by default.
+            *
+            * Found routes are cached by path, together with their captures, evicting the least recently used entry when full.
+            * The cache is split into up to 16 shards by hash of path, each protected by its own mutex.
+            * The capacity is split over the shards, so the cache never holds more than capacity paths.
+            * The cache of a method is cleared when its routes are changed.
+            *
+            * @param[in] capacity - Maximum number of cached paths of each method, 0 disables the cache.
+            *
+            */
+            void cacheCapacity(const size_t capacity);
+
+            /**
+            * Get capacity of lookup cache, per method.
+            *
+            */
+            size_t cacheCapacity() const;
+
+            /**
+            * Get statistics of lookup caches of current routes, summed over all methods.
+            * Must not be called concurrently with changes of routes.
+            *
+            */
+            CacheStatistics cacheStatistics() const;
+
+            /**
+            * Publish current routes as a new snapshot, compiling changed methods.
+            * Must not be called concurrently with changes of routes.
+            *
+            */
+            void publish();
+
+            /**
+            * Get latest published snapshot.
+            * Lock-free, unless the calling thread has not seen the latest version, or last called snapshot() of another router.
+            *
+            * @return Snapshot, kept alive for as long as the returned pointer or a copy of it is held.
+            *
+            */
+            std::shared_ptr<const Snapshot> snapshot() const;
+
         private:
             
             /**
@@ -122,13 +431,29 @@ namespace Wepp
             */
             Router(const Router &) = delete;
 
-            std::map<std::string, RouteMethod*> m_methods; /**< Map of routed methods. */
+            /**
+            * Get all routed methods.
+            *
+            */
+            std::vector<RouteMethod *> methods() const;
+
+            RouteMethod * m_methods[static_cast<size_t>(Method::Custom)];   /**< Routed methods, by enumerator. */
+            std::map<std::string, RouteMethod*> m_customMethods;            /**< Routed custom methods, by name. */
+            std::shared_ptr<const Snapshot> m_snapshot;     /**< Latest published snapshot. */
+            mutable std::mutex m_snapshotMutex;             /**< Mutex protecting the latest published snapshot. */
+            std::atomic<uint64_t> m_version;                /**< Version of latest published snapshot, unique among all routers. */
+            size_t m_cacheCapacity;                         /**< Capacity of lookup cache, per method. */
 
         };
 
         /**
         * Http method routing class.
         *
+        * Routes are registered into a tree of directories, compiling tag patterns once.
+        * The tree is compiled into a radix trie of contiguous nodes at the first lookup or Router::publish() after any change,
+        * merging chains of static directories into single nodes. Lookups do not allocate, except for matched tags
+        * and tags with custom regex patterns.
+        * Compiled tries are immutable, holding copies of the route callbacks, and are shared by router snapshots.
         *
         */
         class WEPP_API RouteMethod
@@ -168,11 +493,45 @@ namespace Wepp
             * @param[in] path - Path to find in route tree.
             * @param[out] tags - Vector of matching tags.
             *
-            * @return Found function.
+            * @return Found function. Routes assigned a CaptureCallbackFunc are found by findRoute.
             *
             */
             const Router::CallbackFunc & find(const std::string & path, std::vector<std::string> & matches) const;
 
+            /**
+            * Find route by path.
+            * Static directories are preferred over tags, without backtracking.
+            *
+            * @param[in] path - Path to find in route tree.
+            * @param[out] tags - Vector of matching tags.
+            *
+            * @return Found route, or nullptr if not found.
+            *
+            */
+            const RouteCallback * findRoute(const std::string & path, std::vector<std::string> & matches) const;
+
+            /**
+            * Find route by path, capturing typed parameters.
+            *
+            * @param[in] path - Path to find in route tree.
+            * @param[out] parameters - Vector of matching parameters.
+            *
+            * @return Found route, or nullptr if not found.
+            *
+            */
+            const RouteCallback * findRoute(const std::string & path, std::vector<RouteParameter> & parameters) const;
+
+            /**
+            * Find route by path, capturing parameters as views into path.
+            *
+            * @param[in] path - Path to find in route tree.
+            * @param[out] captures - Matching parameters.
+            *
+            * @return Found route, or nullptr if not found.
+            *
+            */
+            const RouteCallback * findRoute(const StringView & path, RouteCaptures & captures) const;
+
         private:
 
             /**
@@ -181,28 +540,22 @@ namespace Wepp
             */
             RouteMethod(const RouteMethod &) = delete;
 
-            struct RouteNode;
-            typedef std::map<std::string, RouteNode*> RouteTree;  /**< Route regular tree map typedef. */
+            friend class Router;
 
+            struct RouteNode;
 
             /**
-            * Structure describing a node of the route tree.
+            * Get compiled trie, compiling the route tree if changed since last compiled.
             *
             */
-            struct RouteNode
-            {
-                RouteNode();
-                ~RouteNode();
-
-                RouteTree regularTree;
-                RouteTree tagTree;
-                RouteCallback * routeCallback;
-                std::string dir;
-            };
-
+            std::shared_ptr<const RouteTrie> trie() const;
 
-            std::string m_name;     /**< Name of method. */
-            RouteNode m_rootNode;   /**< Root note of route path tree. */
+            std::string m_name;                             /**< Name of method. */
+            std::unique_ptr<RouteNode> m_rootNode;          /**< Root node of registered route path tree. */
+            size_t m_cacheCapacity;                         /**< Capacity of lookup cache of compiled trie. */
+            mutable std::shared_ptr<const RouteTrie> m_trie; /**< Compiled trie, accessed atomically. */
+            mutable std::atomic_bool m_compiled;            /**< Flag, indicating if the trie is up to date. */
+            mutable std::mutex m_compileMutex;              /**< Mutex protecting compilation. */
 
         };
 
@@ -229,10 +582,49 @@ namespace Wepp
             */
             RouteCallback & operator=(const Router::CallbackFunc & callback);
 
-            Router::CallbackFunc callback; /**< Callback function. */
+            /**
+            * Assigning callback function, receiving the captured parameters.
+            *
+            */
+            RouteCallback & operator=(const Router::CaptureCallbackFunc & callback);
+
+            /**
+            * Assigning streaming callback functions.
+            *
+            * @param[in] onData - Function called for each slice of the request body.
+            * @param[in] onEnd - Function called when the whole body has been received.
+            *
+            */
+            RouteCallback & stream(const Router::DataFunc & onData, const Router::CallbackFunc & onEnd);
+
+            /**
+            * Assigning streaming callback functions, receiving the captured parameters when the whole body has been received.
+            *
+            */
+            RouteCallback & stream(const Router::DataFunc & onData, const Router::CaptureCallbackFunc & onEnd);
+
+            /**
+            * Checks if any callback function is assigned.
+            *
+            */
+            bool routed() const;
+
+            Router::CallbackFunc callback;                  /**< Callback function. */
+            Router::CaptureCallbackFunc captureCallback;    /**< Callback function receiving captures, used instead of callback if set. */
+            Router::DataFunc dataCallback;                  /**< Body data function, or nullptr if the body is buffered. */
 
         private:
 
+            friend class RouteMethod;
+
+            /**
+            * Mark route method as changed.
+            *
+            */
+            void changed();
+
+            std::atomic_bool * m_compiled;  /**< Compiled flag of route method, cleared when assigned. */
+
             /**
             * Deleted copy constructor.
             *
@@ -28,13 +28,15 @@
 
 #include "wepp/build.hpp"
 #include "wepp/http/router.hpp"
+#include "wepp/http/staticRouter.hpp"
 #include "wepp/task.hpp"
-//#include "wepp/priv/receivePool.hpp"
 #include "wepp/priv/receivePool.hpp"
-#include "wepp/socket/tcpListener.hpp"
+#include "wepp/priv/poller.hpp"
+#include "wepp/socket/tcpAcceptor.hpp"
 #include <thread>
 #include <mutex>
-#include <queue>
+#include <map>
+#include <chrono>
 
 /**
 * Wepp namespace.
@@ -53,6 +55,9 @@ namespace Wepp
         /**
         * Http server.
         *
+        * Connections are accepted and read by a single poller thread.
+        * A connection is handed over to the receive pool when a complete request has been received,
+        * and parked in the poller again when its worker has answered and no further request is buffered.
         *
         */
         class WEPP_API Server
@@ -60,11 +65,41 @@ namespace Wepp
 
         public:
 
+            /**
+            * Server settings.
+            *
+            */
+            struct WEPP_API Settings
+            {
+                /**
+                * Constructor, setting default values.
+                *
+                */
+                Settings();
+
+                size_t keepAliveMaxRequests;                        /**< Maximum number of requests per connection. Default: 1000. 1 disables keep-alive. */
+                std::chrono::duration<double> keepAliveTimeout;     /**< Maximum idle time between requests of a connection. Default: 5 seconds. */
+                size_t bodyMemoryLimit;                             /**< Body size above which the body is spilled to a temporary file. Default: 1 MiB. 0 disables spilling. */
+                uint64_t bodySizeLimit;                             /**< Maximum body size, larger bodies are answered with PayloadTooLarge. Default: 64 MiB. */
+            };
+
+            /**
+            * Function finding route of request, replacing route. See StaticRouter.
+            *
+            * @param[in] method - Name of method.
+            * @param[in] path - Requested path.
+            * @param[out] captures - Matching parameters.
+            *
+            * @return Found route, or nullptr if not found.
+            *
+            */
+            typedef std::function<const RouteCallback *(const StringView & method, const StringView & path, RouteCaptures & captures)> FindRouteFunc;
+
             /**
             * Constuctor.
             *
             */
-            Server();
+            Server(const Settings & settings = Settings());
 
             /**
             * Destructor.
@@ -92,28 +127,117 @@ namespace Wepp
 
             /**
             * Class containing all the routes.
+            * Routes are published when the server is started. Routes changed after that are served once published
+            * via route.publish(), while requests in flight finish with the routes they were routed by.
             *
-            * @remark Do not change any routes when the server has been started via start().
+            * @remark Routes must only be changed and published by one thread at a time.
             *
             */
             Router route;
 
+            /**
+            * Find routes by function instead of route, typically a StaticRouter.
+            * The function, and anything it refers to, must outlive the server.
+            *
+            * @remark Do not change when the server has been started via start().
+            *
+            */
+            void routeFinder(const FindRouteFunc & findRoute);
+
+            /**
+            * Find routes by static router instead of route.
+            * Requests are routed without a FindRouteFunc, and handlers are called directly instead of through RouteCallback.
+            * The router must outlive the server.
+            *
+            * @remark Do not change when the server has been started via start().
+            *
+            */
+            template<typename ... Handlers>
+            void routeFinder(const StaticRouter<Handlers...> & router);
+
         private:
 
+            /**
+            * Function finding route of static router, see StaticRouter::findRoute.
+            *
+            */
+            typedef const RouteCallback * (*StaticFindRouteFunc)(const void * router, const StringView & method, const StringView & path, RouteCaptures & captures);
+
+            /**
+            * Function calling handler of route of static router, see StaticRouter::call.
+            *
+            */
+            typedef void (*StaticCallRouteFunc)(const void * router, const RouteCallback * route, const Request & request, Response & response, const RouteCaptures & captures);
+
             /**
             * Internal function for handling the stop tasks.
             *
             */
             void handleStop();
 
-            std::thread m_thread;                       /**< Main thread. */
-            Socket::TcpListener m_listener;             /**< Tcp listener. */
+            /**
+            * Accept all pending connections and register them to the poller.
+            * Pending connections are shed when out of descriptors.
+            *
+            * @return true if no connection is pending, false if accepting failed and should be retried.
+            *
+            */
+            bool acceptConnections();
+
+            /**
+            * Receive available data of connection, and hand it over to the receive pool.
+            *
+            */
+            void receiveConnection(Priv::HttpConnection * connection);
+
+            /**
+            * Worker function, parsing received data and responding to complete requests.
+            * The connection is parked when all received data is parsed.
+            *
+            * @return true if the connection was parked, false if it should be dropped.
+            *
+            */
+            bool handleConnection(std::shared_ptr<Priv::HttpConnection> connection);
+
+            /**
+            * Return an idle connection to the poller, waiting for its next request.
+            *
+            * @return true if the connection was parked, false if the server is stopping or rearming failed.
+            *
+            */
+            bool parkConnection(std::shared_ptr<Priv::HttpConnection> connection);
+
+            /**
+            * Close connections being idle for longer than the keep-alive timeout.
+            *
+            */
+            void closeIdleConnections();
+
+            /**
+            * Unregister a connection being dropped from the poller.
+            * Must be called before its socket is closed.
+            *
+            */
+            void closeConnection(Priv::HttpConnection & connection);
+
+            typedef std::map<Priv::HttpConnection *, std::shared_ptr<Priv::HttpConnection>> ConnectionMap;
+
+            const Settings m_settings;                  /**< Server settings. */
+            FindRouteFunc m_findRoute;                  /**< Function finding routes, or nullptr to use route. */
+            const void * m_staticRouter;                /**< Static router, or nullptr to use m_findRoute or route. */
+            StaticFindRouteFunc m_staticFindRoute;      /**< Function finding routes of static router. */
+            StaticCallRouteFunc m_staticCallRoute;      /**< Function calling handlers of static router. */
+            std::thread m_thread;                       /**< Main thread, running the poller loop. */
+            Socket::TcpAcceptor m_acceptor;             /**< Non-blocking tcp acceptor. */
+            Priv::Poller m_poller;                      /**< Poller of acceptor and connections. */
+            ConnectionMap m_connections;                /**< Connections waiting for more data. */
+            std::mutex m_connectionsMutex;              /**< Mutex protecting the connection map. */
             std::atomic_bool m_running;                 /**< Flag, indicating if server is running. */
             std::atomic_bool m_stopped;                 /**< Flag, indicating if server has been stopped. */
             TaskController<> m_stopTask;                /**< Task for stopping the server. */
             std::mutex m_stopQueueMutex;                /**< Mutex for the stop queue. */
 
-            Priv::ReceivePool m_receivePool;
+            Priv::ReceivePool m_receivePool;            /**< Pool of workers, parsing and handling requests. */
 
         };
 
@@ -121,4 +245,6 @@ namespace Wepp
 
 }
 
+#include "wepp/http/server.inl"
+
 #endif
@@ -0,0 +1,52 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+namespace Wepp
+{
+
+    namespace Http
+    {
+
+        // Server class.
+        template<typename ... Handlers>
+        void Server::routeFinder(const StaticRouter<Handlers...> & router)
+        {
+            typedef StaticRouter<Handlers...> RouterType;
+
+            // Captureless functions, instantiated for the type of router, so handlers are called without type erasure.
+            m_findRoute = nullptr;
+            m_staticRouter = &router;
+            m_staticFindRoute = [](const void * staticRouter, const StringView & method, const StringView & path, RouteCaptures & captures)
+            {
+                return static_cast<const RouterType *>(staticRouter)->findRoute(method, path, captures);
+            };
+            m_staticCallRoute = [](const void * staticRouter, const RouteCallback * route, const Request & request, Response & response, const RouteCaptures & captures)
+            {
+                static_cast<const RouterType *>(staticRouter)->call(route, request, response, captures);
+            };
+        }
+
+    }
+
+}
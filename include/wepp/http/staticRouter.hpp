@@ -0,0 +1,192 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+#ifndef WEPP_HTTP_STATIC_ROUTER_HPP
+#define WEPP_HTTP_STATIC_ROUTER_HPP
+
+#include "wepp/build.hpp"
+#include "wepp/http/router.hpp"
+#include "wepp/priv/routeScan.hpp"
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+/**
+* Wepp namespace.
+*
+*/
+namespace Wepp
+{
+
+    /**
+    * Http namespace.
+    *
+    */
+    namespace Http
+    {
+
+        /**
+        * Route of a static router, see makeStaticRouter.
+        *
+        */
+        template<typename Handler>
+        struct StaticRoute
+        {
+            Method method;      /**< Method of route. */
+            const char * path;  /**< Path pattern of route, string literal. */
+            Handler handler;    /**< Handler, callable as Router::CallbackFunc or Router::CaptureCallbackFunc. */
+        };
+
+        /**
+        * Create static route.
+        *
+        * @param[in] method - Method of route.
+        * @param[in] path - Path pattern of route, must outlive the router. Only typed tags are supported, see RouteParameter.
+        * @param[in] handler - Handler, callable as Router::CallbackFunc or Router::CaptureCallbackFunc.
+        *
+        */
+        template<typename Handler>
+        StaticRoute<Handler> staticRoute(const Method method, const char * path, Handler handler);
+
+        /**
+        * Http routing class, for routes fixed at build time.
+        *
+        * Routes and handlers are template arguments, stored by value without any heap allocated nodes.
+        * Patterns are parsed once at construction, and routes are bucketed by method.
+        * Lookups only try the routes of the requested method, in declaration order,
+        * and the matching route is given by a RouteCallback, as for Router.
+        *
+        * Pass to Server::routeFinder to route requests of a server, calling the handlers directly,
+        * or use as Server::FindRouteFunc via std::cref.
+        *
+        * Unlike Router, custom methods are never routed: findRoute by method name returns nullptr for any
+        * method not given by the Method enumeration, and routes of Method::Custom never match.
+        *
+        */
+        template<typename ... Handlers>
+        class StaticRouter
+        {
+
+            static_assert(sizeof...(Handlers) > 0, "Static router requires at least one route.");
+
+        public:
+
+            /**
+            * Constructor.
+            *
+            * @throw std::invalid_argument if the path pattern of any route is invalid or unsupported.
+            *
+            */
+            explicit StaticRouter(StaticRoute<Handlers> ... routes);
+
+            /**
+            * Move constructor.
+            *
+            */
+            StaticRouter(StaticRouter && router);
+
+            /**
+            * Deleted copy constructor.
+            *
+            */
+            StaticRouter(const StaticRouter &) = delete;
+
+            /**
+            * Get number of routes.
+            *
+            */
+            static constexpr size_t size();
+
+            /**
+            * Find route by method and path, capturing parameters as views into path.
+            *
+            * @param[in] method - Name of method.
+            * @param[in] path - Path to find.
+            * @param[out] captures - Matching parameters.
+            *
+            * @return Found route, or nullptr if not found.
+            *
+            */
+            const RouteCallback * findRoute(const StringView & method, const StringView & path, RouteCaptures & captures) const;
+
+            /**
+            * Find route by method enumerator, see findRoute.
+            *
+            */
+            const RouteCallback * findRoute(const Method method, const StringView & path, RouteCaptures & captures) const;
+
+            /**
+            * Find route, see findRoute.
+            *
+            */
+            const RouteCallback * operator()(const StringView & method, const StringView & path, RouteCaptures & captures) const;
+
+            /**
+            * Call handler of route directly, without going through the functions of the route callback.
+            *
+            * @param[in] route - Route found by this router.
+            * @param[in] request - Request of route.
+            * @param[out] response - Response of route.
+            * @param[in] captures - Parameters captured by route.
+            *
+            */
+            void call(const RouteCallback * route, const Request & request, Response & response, const RouteCaptures & captures) const;
+
+        private:
+
+            static constexpr size_t s_methodCount = static_cast<size_t>(Method::Custom);
+
+            template<size_t ... Indices>
+            void init(std::index_sequence<Indices...>);
+
+            template<size_t ... Indices>
+            void call(const size_t index, const Request & request, Response & response, const RouteCaptures & captures, std::index_sequence<Indices...>) const;
+
+            std::tuple<StaticRoute<Handlers>...> m_routes;          /**< Routes. */
+            Priv::RoutePattern m_patterns[sizeof...(Handlers)];     /**< Parsed patterns of routes. */
+            RouteCallback m_callbacks[sizeof...(Handlers)];         /**< Callbacks, referring to the handlers of routes. */
+            size_t m_order[sizeof...(Handlers)];                    /**< Indices of routes, ordered by method. */
+            size_t m_methodBegin[s_methodCount + 1];                /**< First position in m_order of each method. */
+
+        };
+
+        /**
+        * Create static router.
+        *
+        * Example:
+        *   auto router = Http::makeStaticRouter(
+        *       Http::staticRoute(Http::Method::Get, "/user/<id:int>", [](const Http::Request &, Http::Response &, const Http::RouteCaptures &) {}),
+        *       Http::staticRoute(Http::Method::Post, "/user", [](const Http::Request &, Http::Response &) {}));
+        *
+        */
+        template<typename ... Handlers>
+        StaticRouter<Handlers...> makeStaticRouter(StaticRoute<Handlers> ... routes);
+
+    }
+
+}
+
+#include "wepp/http/staticRouter.inl"
+
+#endif
@@ -0,0 +1,181 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+namespace Wepp
+{
+
+    namespace Priv
+    {
+
+        // Call route handler receiving captures.
+        template<typename Handler>
+        auto invokeRouteHandler(const Handler & handler, const Http::Request & request, Http::Response & response,
+                                const Http::RouteCaptures & captures, int) -> decltype(handler(request, response, captures), void())
+        {
+            handler(request, response, captures);
+        }
+
+        // Call route handler without captures.
+        template<typename Handler>
+        void invokeRouteHandler(const Handler & handler, const Http::Request & request, Http::Response & response,
+                                const Http::RouteCaptures &, long)
+        {
+            handler(request, response);
+        }
+
+    }
+
+    namespace Http
+    {
+
+        // Static route.
+        template<typename Handler>
+        StaticRoute<Handler> staticRoute(const Method method, const char * path, Handler handler)
+        {
+            return StaticRoute<Handler>{ method, path, std::move(handler) };
+        }
+
+
+        // Static router class.
+        template<typename ... Handlers>
+        StaticRouter<Handlers...>::StaticRouter(StaticRoute<Handlers> ... routes) :
+            m_routes(std::move(routes)...)
+        {
+            init(std::index_sequence_for<Handlers...>());
+        }
+
+        template<typename ... Handlers>
+        StaticRouter<Handlers...>::StaticRouter(StaticRouter && router) :
+            m_routes(std::move(router.m_routes))
+        {
+            init(std::index_sequence_for<Handlers...>());
+        }
+
+        template<typename ... Handlers>
+        constexpr size_t StaticRouter<Handlers...>::s_methodCount;
+
+        template<typename ... Handlers>
+        constexpr size_t StaticRouter<Handlers...>::size()
+        {
+            return sizeof...(Handlers);
+        }
+
+        template<typename ... Handlers>
+        const RouteCallback * StaticRouter<Handlers...>::findRoute(const StringView & method, const StringView & path, RouteCaptures & captures) const
+        {
+            Method parsedMethod;
+            if (!parseMethod(method, parsedMethod))
+            {
+                captures.reset(path.data());
+                return nullptr;
+            }
+            return findRoute(parsedMethod, path, captures);
+        }
+
+        template<typename ... Handlers>
+        const RouteCallback * StaticRouter<Handlers...>::findRoute(const Method method, const StringView & path, RouteCaptures & captures) const
+        {
+            const size_t methodIndex = static_cast<size_t>(method);
+            if (methodIndex < s_methodCount)
+            {
+                for (size_t i = m_methodBegin[methodIndex]; i < m_methodBegin[methodIndex + 1]; i++)
+                {
+                    const size_t index = m_order[i];
+                    if (m_patterns[index].match(path, captures))
+                    {
+                        return &m_callbacks[index];
+                    }
+                }
+            }
+
+            captures.reset(path.data());
+            return nullptr;
+        }
+
+        template<typename ... Handlers>
+        const RouteCallback * StaticRouter<Handlers...>::operator()(const StringView & method, const StringView & path, RouteCaptures & captures) const
+        {
+            return findRoute(method, path, captures);
+        }
+
+        template<typename ... Handlers>
+        void StaticRouter<Handlers...>::call(const RouteCallback * route, const Request & request, Response & response, const RouteCaptures & captures) const
+        {
+            call(static_cast<size_t>(route - m_callbacks), request, response, captures, std::index_sequence_for<Handlers...>());
+        }
+
+        template<typename ... Handlers>
+        template<size_t ... Indices>
+        void StaticRouter<Handlers...>::init(std::index_sequence<Indices...>)
+        {
+            // Callbacks refer to the handlers, without copying them.
+            int expand[] = { 0, (m_callbacks[Indices] = std::ref(std::get<Indices>(m_routes).handler),
+                                 m_patterns[Indices] = Priv::RoutePattern(std::get<Indices>(m_routes).path), 0)... };
+            (void)expand;
+
+            for (size_t i = 0; i < sizeof...(Handlers); i++)
+            {
+                if (!m_patterns[i].valid())
+                {
+                    throw std::invalid_argument("Invalid path pattern of static route.");
+                }
+            }
+
+            // Bucket routes by method, keeping their declaration order. Custom methods are never matched.
+            const Method methods[] = { std::get<Indices>(m_routes).method... };
+            size_t position = 0;
+            for (size_t method = 0; method < s_methodCount; method++)
+            {
+                m_methodBegin[method] = position;
+                for (size_t i = 0; i < sizeof...(Handlers); i++)
+                {
+                    if (static_cast<size_t>(methods[i]) == method)
+                    {
+                        m_order[position++] = i;
+                    }
+                }
+            }
+            m_methodBegin[s_methodCount] = position;
+        }
+
+        template<typename ... Handlers>
+        template<size_t ... Indices>
+        void StaticRouter<Handlers...>::call(const size_t index, const Request & request, Response & response, const RouteCaptures & captures,
+                                             std::index_sequence<Indices...>) const
+        {
+            // Unrolled into direct calls of the handlers, which may be inlined.
+            int expand[] = { 0, (index == Indices ?
+                                 (Priv::invokeRouteHandler(std::get<Indices>(m_routes).handler, request, response, captures, 0), 0) : 0)... };
+            (void)expand;
+        }
+
+        template<typename ... Handlers>
+        StaticRouter<Handlers...> makeStaticRouter(StaticRoute<Handlers> ... routes)
+        {
+            return StaticRouter<Handlers...>(std::move(routes)...);
+        }
+
+    }
+
+}
@@ -27,6 +27,7 @@
 #define WEPP_HTTP_STATUS_HPP
 
 #include "wepp/build.hpp"
+#include "wepp/stringView.hpp"
 #include <string>
 
 /**
@@ -126,6 +127,14 @@ namespace Wepp
         */
         WEPP_API const std::string & getStatusAsString(const Status status);
 
+        /**
+        * Get pre-serialized status line of status, "HTTP/1.1 <code> <reason>\r\n".
+        *
+        * @return View of status line, or an empty view if status is unknown.
+        *
+        */
+        WEPP_API StringView getStatusLine(const Status status);
+
     }
 
 }
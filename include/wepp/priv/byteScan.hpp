@@ -0,0 +1,76 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#ifndef WEPP_PRIV_BYTE_SCAN_HPP
+#define WEPP_PRIV_BYTE_SCAN_HPP
+
+#include "wepp/build.hpp"
+
+/**
+* Wepp namespace.
+*
+*/
+namespace Wepp
+{
+
+    /**
+    * Private namespace.
+    *
+    */
+    namespace Priv
+    {
+
+        /**
+        * Find first occurrence of byte.
+        *
+        * Scans 32 or 16 bytes at a time with AVX2 or SSE2, selected at runtime, falling back to a scalar loop.
+        *
+        * @return Pointer to found byte, or end if not found.
+        *
+        */
+        WEPP_API const char * findByte(const char * begin, const char * end, const char byte);
+
+        /**
+        * Find first control byte, that is any byte less than or equal to limit, or DEL(0x7F).
+        * Bytes of obs-text(0x80-0xFF) are never matched.
+        *
+        * Use limit 0x20 to stop at space or control bytes, or 0x1F to stop at control bytes only(including tab).
+        *
+        * @return Pointer to found byte, or end if not found.
+        *
+        */
+        WEPP_API const char * findControl(const char * begin, const char * end, const unsigned char limit);
+
+        /**
+        * Get name of instruction set used by the scanning functions: "avx2", "sse2" or "scalar".
+        *
+        */
+        WEPP_API const char * byteScanInstructionSet();
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,113 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#ifndef WEPP_PRIV_DATE_CLOCK_HPP
+#define WEPP_PRIV_DATE_CLOCK_HPP
+
+#include "wepp/build.hpp"
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+
+/**
+* Wepp namespace.
+*
+*/
+namespace Wepp
+{
+
+    /**
+    * Private namespace.
+    *
+    */
+    namespace Priv
+    {
+
+        /**
+        * Date clock class, providing the current date as IMF-fixdate for Date header fields.
+        *
+        * The date is rendered at most once per second, by the first caller of a new second.
+        * It is stored in atomic words guarded by a sequence lock: readers copy the words without locking,
+        * and retry if the sequence changed while copying.
+        *
+        */
+        class WEPP_API DateClock
+        {
+
+        public:
+
+            static const size_t dateSize = 29; /**< Size of IMF-fixdate, "Sun, 06 Nov 1994 08:49:37 GMT". */
+
+            /**
+            * Constructor.
+            *
+            */
+            DateClock();
+
+            /**
+            * Deleted copy constructor.
+            *
+            */
+            DateClock(const DateClock &) = delete;
+
+            /**
+            * Copy current date into output.
+            *
+            * @param[out] output - Output of exactly dateSize bytes. Not null terminated.
+            *
+            */
+            void copy(char * output);
+
+            /**
+            * Render time as IMF-fixdate, without depending on locale or the non-reentrant gmtime.
+            *
+            * @param[in] time    - Seconds since epoch, UTC.
+            * @param[out] output - Output of exactly dateSize bytes. Not null terminated.
+            *
+            */
+            static void format(const std::time_t time, char * output);
+
+        private:
+
+            static const size_t s_wordCount = (dateSize + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+            /**
+            * Render date of second into the words, unless another thread already does.
+            *
+            */
+            void update(const std::time_t second);
+
+            std::atomic<uint64_t>       m_words[s_wordCount];   /**< Rendered date. */
+            std::atomic<uint32_t>       m_sequence;             /**< Sequence of writes, odd while the words are written. */
+            std::atomic<std::time_t>    m_second;               /**< Second of current date. */
+            std::atomic_flag            m_updating;             /**< Set while the date is rendered. */
+
+        };
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,224 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#ifndef WEPP_PRIV_HTTP_CONNECTION_HPP
+#define WEPP_PRIV_HTTP_CONNECTION_HPP
+
+#include "wepp/build.hpp"
+#include "wepp/priv/httpReceiver.hpp"
+#include "wepp/http/router.hpp"
+#include "wepp/socket/tcpSocket.hpp"
+#include <memory>
+#include <chrono>
+
+/**
+* Wepp namespace.
+*
+*/
+namespace Wepp
+{
+
+    /**
+    * Private namespace.
+    *
+    */
+    namespace Priv
+    {
+
+        /**
+        * Http connection class, holding the state of an accepted connection.
+        *
+        * The receive buffer and parse state belong to the connection rather than to any worker,
+        * making it possible to fill the buffer from the poller thread and parse it on any worker thread,
+        * resuming a partially received request where the previous worker left off.
+        *
+        */
+        class WEPP_API HttpConnection
+        {
+
+        public:
+
+            /**
+            * Enumerator of different return codes of receiveAvailable().
+            *
+            */
+            enum class ReceiveStatus
+            {
+                Ok,             /**< All available data has been received. */
+                BufferFull,     /**< Data may still be available, but the buffer is full. */
+                Disconnected,   /**< Peer closed the connection. */
+                Error           /**< Socket error. */
+            };
+
+            /**
+            * Constructor.
+            *
+            * @param[in] socket     - Connected, non-blocking socket.
+            * @param[in] bufferSize - Size of receive buffer.
+            *
+            */
+            HttpConnection(std::shared_ptr<Socket::TcpSocket> socket, const size_t bufferSize);
+
+            /**
+            * Deleted copy constructor.
+            *
+            */
+            HttpConnection(const HttpConnection &) = delete;
+
+            /**
+            * Get socket of connection.
+            *
+            */
+            Socket::TcpSocket & socket();
+
+            /**
+            * Get receive buffer of connection.
+            *
+            */
+            HttpReceiverBuffer & buffer();
+
+            /**
+            * Get receiver, holding the parse state of current request.
+            *
+            */
+            HttpReceiver & receiver();
+
+            /**
+            * Get current request.
+            *
+            */
+            Http::Request & request();
+
+            /**
+            * Get response of current request.
+            *
+            */
+            Http::Response & response();
+
+            /**
+            * Get route of current request, nullptr if not yet routed.
+            *
+            */
+            const Http::RouteCallback * routeCallback() const;
+
+            /**
+            * Set route of current request.
+            *
+            */
+            void routeCallback(const Http::RouteCallback * routeCallback);
+
+            /**
+            * Get parameters captured by route of current request.
+            *
+            */
+            Http::RouteCaptures & routeCaptures();
+
+            /**
+            * Keep routes of current request, until the request is handled.
+            *
+            */
+            void routeSnapshot(std::shared_ptr<const Http::Router::Snapshot> snapshot);
+
+            /**
+            * Start a new request, discarding current request, response, route and parse state.
+            *
+            */
+            void resetRequest();
+
+            /**
+            * Receive data until the non-blocking socket would block.
+            *
+            */
+            ReceiveStatus receiveAvailable();
+
+            /**
+            * Send all data, waiting for the non-blocking socket to become writable.
+            *
+            * @param[in] data    - Data to send.
+            * @param[in] size    - Size of data.
+            * @param[in] timeout - Maximum wait for the socket to become writable.
+            *
+            * @return true if all data were sent, else false.
+            *
+            */
+            bool send(const char * data, const size_t size, const std::chrono::duration<double> timeout);
+
+            /**
+            * Send all data of several buffers with gather writes, waiting for the non-blocking socket to become writable.
+            * Partially sent buffers are resumed, without copying them together.
+            *
+            * @param[in] buffers - Buffers to send, in order.
+            * @param[in] count   - Number of buffers.
+            * @param[in] timeout - Maximum wait for the socket to become writable.
+            *
+            * @return true if all data were sent, else false.
+            *
+            */
+            bool send(const Socket::SendBuffer * buffers, const size_t count, const std::chrono::duration<double> timeout);
+
+            /**
+            * Get number of requests handled by this connection.
+            *
+            */
+            size_t requestCount() const;
+
+            /**
+            * Increment number of handled requests.
+            *
+            */
+            void countRequest();
+
+            /**
+            * Mark the connection as active right now.
+            *
+            */
+            void touch();
+
+            /**
+            * Get time of latest activity.
+            *
+            */
+            std::chrono::steady_clock::time_point lastActivity() const;
+
+        private:
+
+            std::shared_ptr<Socket::TcpSocket>  m_socket;       /**< Socket of connection. */
+            HttpReceiverBuffer                  m_buffer;       /**< Receive buffer, kept between receive calls. */
+            HttpReceiver                        m_receiver;     /**< Parse state, kept between receive calls. */
+            Http::Request                       m_request;      /**< Current request. */
+            Http::Response                      m_response;     /**< Response of current request. */
+            const Http::RouteCallback *         m_routeCallback; /**< Route of current request. */
+            Http::RouteCaptures                 m_routeCaptures; /**< Parameters captured by route of current request. */
+            std::shared_ptr<const Http::Router::Snapshot> m_routeSnapshot; /**< Routes of current request. */
+            size_t                              m_requestCount; /**< Number of handled requests. */
+            std::chrono::steady_clock::time_point m_lastActivity; /**< Time of latest received data or handled request. */
+
+        };
+
+    }
+
+}
+
+#endif
@@ -29,10 +29,12 @@
 #include "wepp/build.hpp"
 #include "wepp/http/request.hpp"
 #include "wepp/http/response.hpp"
+#include "wepp/http/httpParser.hpp"
+#include "wepp/http/chunkedDecoder.hpp"
 #include "wepp/socket/tcpSocket.hpp"
 #include <memory>
 #include <functional>
-#include <regex>
+#include <algorithm>
 
 /**
 * Wepp namespace.
@@ -53,14 +55,6 @@ namespace Wepp
 
         public:
 
-            enum class FindResult
-            {
-                Found,
-                NewlineNotFound,
-                RegexNotFound,
-                ReachedMaxLength
-            };
-
             HttpReceiverBuffer(const size_t size);
 
             void reset();
@@ -71,12 +65,20 @@ namespace Wepp
 
             int receive(Socket::TcpSocket & socket);
             bool receive(const std::string & string);
-      
-            FindResult readLine(std::string & output, const size_t maxLength = 0);
 
-            FindResult regexSearch(std::cmatch & matches, const std::regex & regex, const size_t maxLength = 0);
+            /**
+            * Get pointer to first unread byte. unreadBytes() bytes are available.
+            *
+            */
+            const char * unreadData() const;
 
-            FindResult readNewline();
+            /**
+            * Mark bytes as read.
+            *
+            * @param[in] size - Number of bytes to consume, not exceeding unreadBytes().
+            *
+            */
+            void consume(const size_t size);
 
             template<typename Container>
             size_t readAll(Container & container)
@@ -93,9 +95,6 @@ namespace Wepp
 
         private:
 
-            void findNewline(const size_t maxLength = 0);
-
-            bool makeSpace();
             bool makeSpace(const size_t requiredSpace);
 
             const size_t            m_bufferSize;
@@ -104,9 +103,6 @@ namespace Wepp
             char *                  m_currentReceivePointer;
             const char *            m_bufferEndPointer;
             char *                  m_currentPointer;
-            char *                  m_newlinePointer;
-            char *                  m_lastFindnewlinePointer;
-            FindResult              m_newlineResult;
 
         };
 
@@ -114,6 +110,10 @@ namespace Wepp
         /**
         * Http receiver class.
         *
+        * The receiver holds the parse state of a single connection. parse() consumes whatever is buffered
+        * and returns NeedMore when the request is incomplete, so parsing can resume on any thread once
+        * the connection has received more data.
+        *
         */
         class WEPP_API HttpReceiver
         {
@@ -121,15 +121,15 @@ namespace Wepp
         public:
             
             /**
-            * Enumerator of different return codes of receive().
+            * Enumerator of different return codes of parse().
             *
             */
             enum class Status
             {
                 Ok,
-                Disconnected,
-                PeerError,
-                InternalError
+                NeedMore,
+                ExpectContinue,
+                PeerError
             };
 
             /**
@@ -138,36 +138,83 @@ namespace Wepp
             * @param[in] limitRequestLine       - Maximum allowed length of request line. Default: 8192. Clamped: 32 minimum.
             * @param[in] limitHeaderFieldLine   - Maximum allowed length of header line. Default: 8192. Clamped: 3 minimum.
             * @param[in] limitHeaderFieldCount  - Maximum allowed numbers of header fields. Default: 512. 
-            * @param[in] bufferSize             - Internal size of buffers. Default: 131072. Clamped: 512 minimum or, value of limitRequestLine or limitHeaderLine.
             *
             */
             HttpReceiver(const size_t limitRequestLine = 8192, const size_t limitHeaderFieldLine = 8192,
-                         const size_t limitHeaderFieldCount = 512, const size_t bufferSize = 131072);
+                         const size_t limitHeaderFieldCount = 512);
 
             /**
-            * Receive and parse data.
+            * Discard the parse state of any partially parsed request.
             *
-            * The receive method internally uses two sets of buffers, used for swapping if one of them gets full.
+            */
+            void reset();
+
+            /**
+            * Parse buffered data of request, without receiving.
+            * The request line and header section are parsed by HttpParser.
+            * Fields of request are views into buffer while parsing succeeds.
+            * Request is materialized before NeedMore is returned, the buffer may receive more data after that.
+            *
+            * Request, response and callbacks must be the same when parsing is resumed.
+            * The state is reset after Ok or PeerError is returned, ready for the next request.
             *
+            * @param[in] buffer      - Receive buffer of connection.
             * @param[out] request    - Output data of request.
-            * @param[out] request    - Output data of response.
+            * @param[out] response   - Output data of response.
             * @param[in] onRequest   - Function executed when the request line has been received. The receiver is cancelled if the function returns false.
-            * @param[in] onHeaders   - Function executed when all headers are received. The receiver is cancelled if the function returns false.
-            
+            * @param[in] onData      - Function executed for each slice of the body, viewing the buffer. The receiver is cancelled if the function returns false.
+            *                          The body is appended to request.body() if nullptr.
+            *
+            * @return Ok if the request is complete.
+            *         NeedMore if all buffered data is consumed and the request is incomplete.
+            *         ExpectContinue if the request has "Expect: 100-continue", was accepted by onRequest and the body size limit,
+            *                        and none of the body has been received. "100 Continue" should be sent before parsing is resumed.
+            *         PeerError if the request is invalid or rejected, see response.status().
             *
             */
-            Status receive(std::shared_ptr<Socket::TcpSocket> socket,
-                           Http::Request & request, Http::Response & response,
-                           std::function<bool(Http::Request &, Http::Response &)> onRequest);
+            Status parse(HttpReceiverBuffer & buffer, Http::Request & request, Http::Response & response,
+                         std::function<bool(Http::Request &, Http::Response &)> onRequest,
+                         std::function<bool(Http::Request &, Http::Response &, const StringView &)> onData = nullptr);
+
+            /**
+            * Set maximum allowed size of request bodies.
+            * Larger bodies are answered with PayloadTooLarge, before any of the body is received if its length is known.
+            *
+            * @param[in] limit - Maximum body size. Default: no limit.
+            *
+            */
+            void limitBodySize(const uint64_t limit);
+
+            /**
+            * Get maximum allowed size of request bodies.
+            *
+            */
+            uint64_t limitBodySize() const;
 
         private:
 
-            const size_t m_limitRequestLine;                 /**< .*/
-            const size_t m_limitHeaderFieldLine;             /**< .*/
-            const size_t m_limitHeaderFieldCount;            /**< .*/
-            const size_t m_bufferSize;                       /**< Size of buffers.*/
+            /**
+            * Enumerator of parse states.
+            *
+            */
+            enum class State
+            {
+                Head,
+                Body,
+                ChunkedBody
+            };
+
+            /**
+            * Reset parse state and return status.
+            *
+            */
+            Status finish(const Status status);
 
-            HttpReceiverBuffer m_buffer;
+            Http::HttpParser m_parser;                       /**< Parser of request line and headers.*/
+            Http::ChunkedDecoder m_chunkedDecoder;           /**< Decoder of chunked request bodies.*/
+            uint64_t m_limitBodySize;                        /**< Maximum size of request bodies.*/
+            State m_state;                                   /**< Current parse state.*/
+            uint64_t m_remaining;                            /**< Remaining bytes of content-length body.*/
 
         };
 
@@ -0,0 +1,170 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#ifndef WEPP_PRIV_OUTPUT_BUFFER_HPP
+#define WEPP_PRIV_OUTPUT_BUFFER_HPP
+
+#include "wepp/build.hpp"
+#include "wepp/stringView.hpp"
+#include <memory>
+#include <cstdint>
+
+/**
+* Wepp namespace.
+*
+*/
+namespace Wepp
+{
+
+    /**
+    * Private namespace.
+    *
+    */
+    namespace Priv
+    {
+
+        /**
+        * Maximum number of digits written by formatInteger.
+        *
+        */
+        static const size_t maxIntegerDigits = 20;
+
+        /**
+        * Format unsigned integer as decimal digits, two digits at a time.
+        *
+        * @param[in] value  - Value to format.
+        * @param[out] output - Output of at least maxIntegerDigits bytes. Not null terminated.
+        *
+        * @return Number of written digits.
+        *
+        */
+        WEPP_API size_t formatInteger(uint64_t value, char * output);
+
+        /**
+        * Output buffer class, serializing responses without allocating once grown to fit them.
+        *
+        * Clearing the buffer keeps its memory, making it reusable for every response of a connection.
+        *
+        */
+        class WEPP_API OutputBuffer
+        {
+
+        public:
+
+            /**
+            * Constructor.
+            *
+            * @param[in] capacity - Initial capacity in bytes.
+            *
+            */
+            OutputBuffer(const size_t capacity = 4096);
+
+            /**
+            * Deleted copy constructor.
+            *
+            */
+            OutputBuffer(const OutputBuffer &) = delete;
+
+            /**
+            * Append data.
+            *
+            */
+            void append(const char * data, const size_t size);
+
+            /**
+            * Append string view.
+            *
+            */
+            void append(const StringView & data);
+
+            /**
+            * Extend buffered data by size bytes, to be written through the returned pointer.
+            * The pointer is valid until the buffer is modified.
+            *
+            */
+            char * extend(const size_t size);
+
+            /**
+            * Append unsigned integer as decimal digits.
+            *
+            */
+            void appendInteger(const uint64_t value);
+
+            /**
+            * Get pointer to buffered data.
+            *
+            */
+            const char * data() const;
+
+            /**
+            * Get size of buffered data.
+            *
+            */
+            size_t size() const;
+
+            /**
+            * Get capacity of buffer.
+            *
+            */
+            size_t capacity() const;
+
+            /**
+            * Checks if no data is buffered.
+            *
+            */
+            bool empty() const;
+
+            /**
+            * Discard buffered data, keeping memory of buffer.
+            *
+            */
+            void clear();
+
+            /**
+            * Release memory exceeding given capacity, if no data is buffered.
+            * Keeps connections from holding on to memory of a single large response.
+            *
+            */
+            void shrink(const size_t capacity);
+
+        private:
+
+            /**
+            * Grow buffer to fit additional bytes.
+            *
+            */
+            void reserve(const size_t additional);
+
+            std::unique_ptr<char[]> m_data;     /**< Buffered data. */
+            size_t                  m_size;     /**< Size of buffered data. */
+            size_t                  m_capacity; /**< Size of allocated memory. */
+
+        };
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,159 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#ifndef WEPP_PRIV_POLLER_HPP
+#define WEPP_PRIV_POLLER_HPP
+
+#include "wepp/build.hpp"
+#include "wepp/socket/socket.hpp"
+#include <vector>
+#include <chrono>
+#if defined(WEPP_PLATFORM_WINDOWS)
+    #include <atomic>
+    #include <mutex>
+    #include <map>
+#endif
+
+/**
+* Wepp namespace.
+*
+*/
+namespace Wepp
+{
+
+    /**
+    * Private namespace.
+    *
+    */
+    namespace Priv
+    {
+
+        /**
+        * Socket readiness poller.
+        *
+        * Backed by edge-triggered epoll on Linux and by WSAPoll on Windows.
+        * Handles registered as one-shot are disabled after their first event, until rearm() is called.
+        *
+        */
+        class WEPP_API Poller
+        {
+
+        public:
+
+            /**
+            * Structure of a single readiness event.
+            *
+            */
+            struct Event
+            {
+                void *  data;       /**< User data passed to add() or rearm(). */
+                bool    readable;   /**< Handle is readable, or has a pending connection. */
+                bool    closed;     /**< Peer hung up or an error occurred. */
+            };
+
+            /**
+            * Constructor.
+            *
+            * @throw std::runtime_error if the native poller could not be created.
+            *
+            */
+            Poller();
+
+            /**
+            * Destructor.
+            *
+            */
+            ~Poller();
+
+            /**
+            * Deleted copy constructor.
+            *
+            */
+            Poller(const Poller &) = delete;
+
+            /**
+            * Register a handle for read events.
+            *
+            * @param[in] handle  - Non-blocking socket handle.
+            * @param[in] data    - User data returned by events of this handle.
+            * @param[in] oneShot - Disable the handle after its first event.
+            *
+            */
+            bool add(const Socket::Socket::Handle handle, void * data, const bool oneShot);
+
+            /**
+            * Enable a one-shot handle again.
+            *
+            */
+            bool rearm(const Socket::Socket::Handle handle, void * data);
+
+            /**
+            * Unregister a handle.
+            *
+            */
+            bool remove(const Socket::Socket::Handle handle);
+
+            /**
+            * Wait for events.
+            *
+            * @param[out] events  - Vector of events. Cleared before waiting.
+            * @param[in]  timeout - Maximum duration of wait.
+            *
+            * @return Number of received events. Interrupted waits return 0.
+            *
+            */
+            size_t wait(std::vector<Event> & events, const std::chrono::duration<double> timeout);
+
+            /**
+            * Wake up any thread blocked in wait().
+            *
+            */
+            void interrupt();
+
+        private:
+
+        #if defined(WEPP_PLATFORM_LINUX)
+            int m_epoll;                        /**< Epoll descriptor. */
+            int m_interruptEvent;               /**< Eventfd, used by interrupt(). */
+        #elif defined(WEPP_PLATFORM_WINDOWS)
+            struct Entry
+            {
+                void *  data;
+                bool    oneShot;
+                bool    armed;
+            };
+
+            std::mutex m_mutex;                                 /**< Mutex protecting the entry map. */
+            std::map<Socket::Socket::Handle, Entry> m_entries;  /**< Registered handles. */
+            std::atomic_bool m_interrupted;                     /**< Flag, set by interrupt(). */
+        #endif
+
+        };
+
+    }
+
+}
+
+#endif
@@ -29,7 +29,7 @@
 #include "wepp/build.hpp"
 #include "wepp/priv/threadPool.hpp"
 #include "wepp/socket/tcpSocket.hpp"
-#include "wepp/priv/httpReceiver.hpp"
+#include "wepp/priv/httpConnection.hpp"
 /*#include "wepp/task.hpp"
 #include "wepp/semaphore.hpp"
 #include <atomic>
@@ -61,7 +61,7 @@ namespace Wepp
 
         public:
 
-            typedef std::function<void(HttpReceiver &, std::shared_ptr<Socket::TcpSocket>)> ExecutionFunction;
+            typedef std::function<void(std::shared_ptr<HttpConnection>)> ExecutionFunction;
 
             /**
             * Constructor.
@@ -73,16 +73,15 @@ namespace Wepp
             * Executes the function passed to constructor.
             *
             */
-            virtual void execute(std::shared_ptr<Socket::TcpSocket> socket);
+            virtual void execute(std::shared_ptr<HttpConnection> connection);
 
         private:
 
             ExecutionFunction   m_function;
-            HttpReceiver        m_receiver;
 
         };
 
-        typedef ThreadPool<ReceivePoolWorker<std::shared_ptr<Socket::TcpSocket>>, std::shared_ptr<Socket::TcpSocket>> ReceivePool;
+        typedef ThreadPool<ReceivePoolWorker<std::shared_ptr<HttpConnection>>, std::shared_ptr<HttpConnection>> ReceivePool;
 
     }
 
@@ -35,9 +35,9 @@ namespace Wepp
         { }
 
         template<typename ... Args>
-        void ReceivePoolWorker<Args...>::execute(std::shared_ptr<Socket::TcpSocket> socket)
+        void ReceivePoolWorker<Args...>::execute(std::shared_ptr<HttpConnection> connection)
         {
-            m_function(m_receiver, socket);
+            m_function(connection);
         }
 
     }
@@ -0,0 +1,157 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+#ifndef WEPP_PRIV_ROUTE_SCAN_HPP
+#define WEPP_PRIV_ROUTE_SCAN_HPP
+
+#include "wepp/build.hpp"
+#include "wepp/http/router.hpp"
+#include "wepp/stringView.hpp"
+#include <cstdint>
+
+/**
+* Wepp namespace.
+*
+*/
+namespace Wepp
+{
+
+    /**
+    * Private namespace.
+    *
+    */
+    namespace Priv
+    {
+
+        /**
+        * Parse typed tag, "type" or "name:type", see Http::RouteParameter.
+        *
+        * @param[in] tag - Content of tag, without brackets.
+        * @param[out] name - Name of tag, empty if unnamed.
+        * @param[out] type - Type of tag.
+        *
+        * @return true if tag is typed, false if tag is a regex.
+        *
+        */
+        WEPP_API bool parseTypedTag(const StringView & tag, StringView & name, Http::RouteParameter::Type & type);
+
+        /**
+        * Scan value of typed tag. Integers are converted, failing on overflow. Regex values are not scanned.
+        *
+        * @return true if the whole range is a value of type, else false.
+        *
+        */
+        WEPP_API bool scanRouteValue(const Http::RouteParameter::Type type, const char * begin, const char * end, int64_t & integer);
+
+        /**
+        * Find end of tag, skipping escaped characters.
+        *
+        * @param[in] begin - First character after '<'.
+        *
+        * @return Pointer to '>', or end if not found.
+        *
+        */
+        WEPP_API const char * findTagEnd(const char * begin, const char * end);
+
+        /**
+        * Route pattern of typed tags, parsed once into a fixed array of segments,
+        * and matched against paths without building a route tree.
+        *
+        * A tag matches until the next '/' of path, less the literal text following it in its directory.
+        * Patterns with a directory holding multiple tags, a regex tag, or more tags than RouteCaptures::capacity never match.
+        *
+        */
+        class WEPP_API RoutePattern
+        {
+
+        public:
+
+            /**
+            * Constructor of pattern never matching.
+            *
+            */
+            RoutePattern();
+
+            /**
+            * Constructor, parsing pattern.
+            *
+            * @param[in] pattern - Null terminated route pattern, must outlive this object. Captured names are views into it.
+            *
+            */
+            explicit RoutePattern(const char * pattern);
+
+            /**
+            * Checks if the pattern is supported, and able to match any path.
+            *
+            */
+            bool valid() const;
+
+            /**
+            * Match path against pattern.
+            *
+            * @param[in] path - Path to match.
+            * @param[out] captures - Captured parameters, views into path.
+            *
+            * @return true if matched, else false.
+            *
+            */
+            bool match(const StringView & path, Http::RouteCaptures & captures) const;
+
+        private:
+
+            /**
+            * Segment of pattern, either literal text or a tag followed by the literal text of its directory.
+            * Text is referred to by offsets into the pattern.
+            *
+            */
+            struct Segment
+            {
+                uint16_t literal;                   /**< Offset of literal text. */
+                uint16_t literalSize;               /**< Size of literal text. */
+                uint16_t name;                      /**< Offset of tag name. */
+                uint16_t nameSize;                  /**< Size of tag name. */
+                Http::RouteParameter::Type type;    /**< Type of tag. */
+                bool tag;                           /**< Flag, indicating if segment is a tag. */
+            };
+
+            static const size_t s_maxSegments = 2 * Http::RouteCaptures::capacity + 1;
+
+            /**
+            * Add segment, failing if the segment array is full.
+            *
+            */
+            bool add(const Segment & segment);
+
+            const char * m_pattern;                 /**< Pattern, referred to by segments. */
+            Segment m_segments[s_maxSegments];      /**< Segments of pattern. */
+            size_t m_size;                          /**< Number of segments. */
+            bool m_valid;                           /**< Flag, indicating if pattern is supported. */
+
+        };
+
+    }
+
+}
+
+#endif
@@ -88,8 +88,12 @@ namespace Wepp
         void ThreadWorker<Args...>::executeVirtualHelper(std::index_sequence<Is...>)
         {
             execute(std::get<Is>(m_args)...);
+
+            // Take the arguments before returning, the pool may hand out new work right away.
+            // They are released after returning, as releasing them may let the pool be stopped.
+            std::tuple<Args...> args;
+            std::swap(args, m_args);
             m_pool->returnWorker(this);
-            m_args = std::tuple<Args...>();
         }
 
         // ThreadPool implementations.
@@ -226,6 +230,11 @@ namespace Wepp
 
             if (m_workerSet.find(worker) == m_workerSet.end())
             {
+                // Workers of a stopping pool are being deleted.
+                if (!m_started)
+                {
+                    return;
+                }
                 throw std::runtime_error("Trying to return worker to a thread pool not owning the worker.");
             }
 
@@ -236,24 +245,30 @@ namespace Wepp
         template<typename T, typename ... Args>
         void ThreadPool<T, Args...>::cleanup()
         {
-            std::lock_guard<std::mutex> lock(m_mutex);
-
-            for (auto it = m_workerSet.begin(); it != m_workerSet.end(); it++)
+            // Workers are deleted without holding the lock, busy workers return themselves to the pool before being joined.
+            std::set<Worker *> workers;
             {
-                delete *it;
-            }
-            m_workerSet.clear();
+                std::lock_guard<std::mutex> lock(m_mutex);
 
-            while (m_workerQueue.size())
-            {
-                m_workerQueue.pop();
+                std::swap(workers, m_workerSet);
+
+                while (m_workerQueue.size())
+                {
+                    m_workerQueue.pop();
+                }
+
+                while (m_workQueue.size())
+                {
+                    m_workQueue.pop();
+                }
             }
 
-            while (m_workQueue.size())
+            for (auto it = workers.begin(); it != workers.end(); it++)
             {
-                m_workQueue.pop();
+                delete *it;
             }
 
+            std::lock_guard<std::mutex> lock(m_mutex);
             m_stopped = true;
             m_stoppedTask.finish();
         }
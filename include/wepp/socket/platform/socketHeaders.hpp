@@ -41,11 +41,14 @@
 #elif defined(WEPP_PLATFORM_LINUX)
     #include <unistd.h>
     #include <sys/socket.h>
+    #include <sys/uio.h>
     #include <netinet/in.h>
     #include <fcntl.h>
     #include <netdb.h>
     #include <netinet/in.h>
     #include <arpa/inet.h>
+    #include <poll.h>
+    #include <errno.h>
 #endif
 
 #endif
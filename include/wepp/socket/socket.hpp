@@ -28,6 +28,7 @@
 
 #include "wepp/build.hpp"
 #include "wepp/socket/platform/socketHeaders.hpp"
+#include <chrono>
 
 /**
 * Wepp namespace.
@@ -64,6 +65,12 @@ namespace Wepp
             */
             static void setLastError(const int error);
 
+            /**
+            * Check if latest native error were caused by a non-blocking operation that would block.
+            *
+            */
+            static bool wouldBlock();
+
             /**
             * Handle type.
             *
@@ -104,6 +111,26 @@ namespace Wepp
             */
             bool setBlocking(const bool status) const;
 
+            /**
+            * Wait until the socket is readable.
+            *
+            * @param[in] timeout - Maximum duration of wait.
+            *
+            * @return true if socket is readable, false if the timeout were reached or an error occurred.
+            *
+            */
+            bool waitForRead(const std::chrono::duration<double> timeout) const;
+
+            /**
+            * Wait until the socket is writable.
+            *
+            * @param[in] timeout - Maximum duration of wait.
+            *
+            * @return true if socket is writable, false if the timeout were reached or an error occurred.
+            *
+            */
+            bool waitForWrite(const std::chrono::duration<double> timeout) const;
+
             /**
             * Set the native handle.
             *
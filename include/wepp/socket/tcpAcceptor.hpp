@@ -0,0 +1,141 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#ifndef WEPP_SOCKET_TCP_ACCEPTOR_HPP
+#define WEPP_SOCKET_TCP_ACCEPTOR_HPP
+
+#include "wepp/build.hpp"
+#include "wepp/socket/tcpSocket.hpp"
+#include <memory>
+#include <string>
+
+/**
+* Wepp namespace.
+*
+*/
+namespace Wepp
+{
+
+    /**
+    * Wepp namespace.
+    *
+    */
+    namespace Socket
+    {
+
+        /**
+        * Non-blocking tcp acceptor class.
+        *
+        * Unlike TcpListener, the acceptor does not run any thread of its own.
+        * The handle is meant to be registered to a poller, and accept() called when it's readable.
+        *
+        */
+        class WEPP_API TcpAcceptor : public Socket
+        {
+
+        public:
+
+            /**
+            * Enumerator of results of accept().
+            *
+            */
+            enum class AcceptStatus
+            {
+                Accepted,           /**< A connection was accepted. */
+                WouldBlock,         /**< No connection is pending. */
+                OutOfDescriptors,   /**< The process or system is out of descriptors, a pending connection was accepted and closed. */
+                Error               /**< Unexpected error, pending connections may remain. */
+            };
+
+            /**
+            * Constructor.
+            *
+            */
+            TcpAcceptor();
+
+            /**
+            * Destructor.
+            *
+            */
+            ~TcpAcceptor();
+
+            /**
+            * Deleted copy constructor.
+            *
+            */
+            TcpAcceptor(const TcpAcceptor &) = delete;
+
+            /**
+            * Bind and start listening on a non-blocking socket.
+            *
+            * @param[in] port - Endpoint port.
+            * @param[in] endpoint - Endpoint address.
+            *
+            * @return true if successfully opened, else false.
+            *
+            */
+            bool open(const uint16_t port, const std::string & endpoint = "");
+
+            /**
+            * Close the listening socket.
+            *
+            */
+            void close();
+
+            /**
+            * Accept a pending connection.
+            *
+            * @return Accepted non-blocking socket, or nullptr if no connection is pending.
+            *
+            */
+            std::shared_ptr<TcpSocket> accept();
+
+            /**
+            * Accept a pending connection.
+            * Connections aborted before being accepted are skipped.
+            *
+            * When out of descriptors, a descriptor kept in reserve is released to accept and close the pending connection,
+            * rather than leaving it in the backlog of an edge-triggered poller.
+            *
+            * @param[out] status - Result of accepting.
+            *
+            * @return Accepted non-blocking socket, or nullptr if status is not AcceptStatus::Accepted.
+            *
+            */
+            std::shared_ptr<TcpSocket> accept(AcceptStatus & status);
+
+        private:
+
+        #if defined(WEPP_PLATFORM_LINUX)
+            int m_reserve; /**< Descriptor kept in reserve, released when out of descriptors. */
+        #endif
+
+        };
+
+    }
+
+}
+
+#endif
@@ -45,6 +45,16 @@ namespace Wepp
     namespace Socket
     {
 
+        /**
+        * Buffer of data, sent by scatter/gather I/O.
+        *
+        */
+        struct SendBuffer
+        {
+            const char *    data;   /**< Data to send. */
+            size_t          size;   /**< Size of data. */
+        };
+
         /**
         * Tcp socket class.
         *
@@ -97,6 +107,20 @@ namespace Wepp
             int send(const char * data, const int length);
             int send(const std::string & data);
 
+            /**
+            * Send data of several buffers in a single call, using scatter/gather I/O.
+            * Data may be partially sent, as for send().
+            *
+            * @param[in] buffers - Buffers to send, in order.
+            * @param[in] count   - Number of buffers. At most maxSendBuffers are sent per call.
+            *
+            * @return Number of sent bytes, or -1 on error.
+            *
+            */
+            int sendv(const SendBuffer * buffers, const size_t count);
+
+            static const size_t maxSendBuffers = 64; /**< Maximum number of buffers sent per call of sendv. */
+
         };
 
     }
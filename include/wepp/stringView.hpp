@@ -0,0 +1,142 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#ifndef WEPP_STRING_VIEW_HPP
+#define WEPP_STRING_VIEW_HPP
+
+#include "wepp/build.hpp"
+#include <string>
+#include <ostream>
+
+/**
+* Wepp namespace.
+*
+*/
+namespace Wepp
+{
+
+    /**
+    * Non-owning reference to a sequence of characters.
+    *
+    * Subset of C++17 std::string_view. The referenced memory must outlive the view.
+    *
+    */
+    class WEPP_API StringView
+    {
+
+    public:
+
+        static const size_t npos = static_cast<size_t>(-1);
+
+        /**
+        * Constructing empty view.
+        *
+        */
+        StringView();
+
+        /**
+        * Constructing view of null terminated string.
+        *
+        */
+        StringView(const char * string);
+
+        /**
+        * Constructing view of size characters.
+        *
+        */
+        StringView(const char * data, const size_t size);
+
+        /**
+        * Constructing view of string. The string must not be modified while the view is in use.
+        *
+        */
+        StringView(const std::string & string);
+
+        /**
+        * Get pointer to first character. Not null terminated.
+        *
+        */
+        const char * data() const;
+
+        /**
+        * Get number of characters.
+        *
+        */
+        size_t size() const;
+
+        /**
+        * Checks if view is empty.
+        *
+        */
+        bool empty() const;
+
+        const char * begin() const;
+        const char * end() const;
+
+        char operator[](const size_t index) const;
+
+        /**
+        * Get view of part of this view. Out of range positions are clamped.
+        *
+        */
+        StringView substr(const size_t position, const size_t count = npos) const;
+
+        /**
+        * Find first position of character, starting at position.
+        *
+        * @return Position of character, or npos if not found.
+        *
+        */
+        size_t find(const char character, const size_t position = 0) const;
+
+        /**
+        * Compare views, ignoring case of ASCII letters.
+        *
+        */
+        bool equalsIgnoreCase(const StringView & string) const;
+
+        /**
+        * Get owned copy.
+        *
+        */
+        std::string str() const;
+
+    private:
+
+        const char *    m_data;     /**< Referenced characters. */
+        size_t          m_size;     /**< Number of referenced characters. */
+
+    };
+
+    bool operator == (const StringView & left, const StringView & right);
+    bool operator != (const StringView & left, const StringView & right);
+    bool operator < (const StringView & left, const StringView & right);
+    std::ostream & operator << (std::ostream & stream, const StringView & string);
+
+}
+
+#include "wepp/stringView.inl"
+
+#endif
@@ -0,0 +1,146 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include <cstring>
+#include <algorithm>
+
+namespace Wepp
+{
+
+    inline StringView::StringView() :
+        m_data(""),
+        m_size(0)
+    { }
+
+    inline StringView::StringView(const char * string) :
+        m_data(string),
+        m_size(std::strlen(string))
+    { }
+
+    inline StringView::StringView(const char * data, const size_t size) :
+        m_data(data),
+        m_size(size)
+    { }
+
+    inline StringView::StringView(const std::string & string) :
+        m_data(string.data()),
+        m_size(string.size())
+    { }
+
+    inline const char * StringView::data() const
+    {
+        return m_data;
+    }
+
+    inline size_t StringView::size() const
+    {
+        return m_size;
+    }
+
+    inline bool StringView::empty() const
+    {
+        return m_size == 0;
+    }
+
+    inline const char * StringView::begin() const
+    {
+        return m_data;
+    }
+
+    inline const char * StringView::end() const
+    {
+        return m_data + m_size;
+    }
+
+    inline char StringView::operator[](const size_t index) const
+    {
+        return m_data[index];
+    }
+
+    inline StringView StringView::substr(const size_t position, const size_t count) const
+    {
+        const size_t start = std::min(position, m_size);
+        return StringView(m_data + start, std::min(count, m_size - start));
+    }
+
+    inline size_t StringView::find(const char character, const size_t position) const
+    {
+        if (position >= m_size)
+        {
+            return npos;
+        }
+
+        const void * found = std::memchr(m_data + position, character, m_size - position);
+        return found ? static_cast<size_t>(static_cast<const char *>(found) - m_data) : npos;
+    }
+
+    inline bool StringView::equalsIgnoreCase(const StringView & string) const
+    {
+        if (m_size != string.m_size)
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < m_size; i++)
+        {
+            char a = m_data[i];
+            char b = string.m_data[i];
+            a = (a >= 'A' && a <= 'Z') ? static_cast<char>(a + ('a' - 'A')) : a;
+            b = (b >= 'A' && b <= 'Z') ? static_cast<char>(b + ('a' - 'A')) : b;
+            if (a != b)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    inline std::string StringView::str() const
+    {
+        return std::string(m_data, m_size);
+    }
+
+    inline bool operator == (const StringView & left, const StringView & right)
+    {
+        return left.size() == right.size() && (left.size() == 0 || std::memcmp(left.data(), right.data(), left.size()) == 0);
+    }
+
+    inline bool operator != (const StringView & left, const StringView & right)
+    {
+        return !(left == right);
+    }
+
+    inline bool operator < (const StringView & left, const StringView & right)
+    {
+        return std::lexicographical_compare(left.begin(), left.end(), right.begin(), right.end());
+    }
+
+    inline std::ostream & operator << (std::ostream & stream, const StringView & string)
+    {
+        return stream.write(string.data(), static_cast<std::streamsize>(string.size()));
+    }
+
+}
@@ -0,0 +1,321 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include "wepp/http/body.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#if defined(WEPP_PLATFORM_LINUX)
+    #include <sys/mman.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <errno.h>
+#endif
+
+namespace Wepp
+{
+
+    namespace Http
+    {
+
+        const size_t Body::maxRetainedCapacity;
+
+        Body::Body() :
+            m_spillThreshold(0),
+            m_file(-1),
+            m_fileSize(0),
+            m_map(nullptr),
+            m_mapSize(0),
+            m_spillFailed(false),
+            m_failed(false)
+        { }
+
+        Body::Body(const Body & body) :
+            m_spillThreshold(body.m_spillThreshold),
+            m_file(-1),
+            m_fileSize(0),
+            m_map(nullptr),
+            m_mapSize(0),
+            m_spillFailed(false),
+            m_failed(false)
+        {
+            *this = body;
+        }
+
+        Body::Body(Body && body) noexcept :
+            m_data(std::move(body.m_data)),
+            m_spillThreshold(body.m_spillThreshold),
+            m_file(body.m_file),
+            m_fileSize(body.m_fileSize),
+            m_map(body.m_map),
+            m_mapSize(body.m_mapSize),
+            m_spillFailed(body.m_spillFailed),
+            m_failed(body.m_failed)
+        {
+            body.m_file = -1;
+            body.m_fileSize = 0;
+            body.m_map = nullptr;
+            body.m_mapSize = 0;
+        }
+
+        Body::~Body()
+        {
+            closeFile();
+        }
+
+        Body & Body::operator =(const Body & body)
+        {
+            if (this != &body)
+            {
+                clear();
+                m_spillThreshold = body.m_spillThreshold;
+
+                const char * data = body.data();
+                if (data)
+                {
+                    m_data.assign(data, data + body.size());
+                }
+                m_failed = body.m_failed;
+            }
+            return *this;
+        }
+
+        Body & Body::operator =(Body && body) noexcept
+        {
+            if (this != &body)
+            {
+                closeFile();
+                m_data.swap(body.m_data);
+                m_spillThreshold = body.m_spillThreshold;
+                m_file = body.m_file;
+                m_fileSize = body.m_fileSize;
+                m_map = body.m_map;
+                m_mapSize = body.m_mapSize;
+                m_spillFailed = body.m_spillFailed;
+                m_failed = body.m_failed;
+
+                body.m_data.clear();
+                body.m_file = -1;
+                body.m_fileSize = 0;
+                body.m_map = nullptr;
+                body.m_mapSize = 0;
+                body.m_spillFailed = false;
+                body.m_failed = false;
+            }
+            return *this;
+        }
+
+        char * Body::data()
+        {
+            return const_cast<char *>(static_cast<const Body *>(this)->data());
+        }
+
+        const char * Body::data() const
+        {
+        #if defined(WEPP_PLATFORM_LINUX)
+            if (m_file >= 0)
+            {
+                if (m_map && m_mapSize != m_fileSize)
+                {
+                    unmap();
+                }
+                if (!m_map)
+                {
+                    // Private mapping, keeping data() writable without modifying the file.
+                    void * map = ::mmap(nullptr, m_fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, m_file, 0);
+                    if (map == MAP_FAILED)
+                    {
+                        m_failed = true;
+                        return nullptr;
+                    }
+                    m_map = static_cast<char *>(map);
+                    m_mapSize = m_fileSize;
+                }
+                return m_map;
+            }
+        #endif
+            return m_data.data();
+        }
+
+        size_t Body::size() const
+        {
+            return m_file >= 0 ? m_fileSize : m_data.size();
+        }
+
+        size_t Body::capacity() const
+        {
+            return m_data.capacity();
+        }
+
+        Body & Body::append(const char * data, const size_t size)
+        {
+            if (m_file >= 0)
+            {
+                if (!writeFile(data, size))
+                {
+                    m_failed = true;
+                }
+                return *this;
+            }
+
+            m_data.insert(m_data.end(), data, data + size);
+            if (m_spillThreshold && !m_spillFailed && m_data.size() > m_spillThreshold && !spill())
+            {
+                m_spillFailed = true;
+                m_failed = true;
+            }
+            return *this;
+        }
+
+        void Body::clear()
+        {
+            closeFile();
+            m_spillFailed = false;
+            m_failed = false;
+            if (m_data.capacity() > maxRetainedCapacity)
+            {
+                std::vector<char>().swap(m_data);
+            }
+            else
+            {
+                m_data.clear();
+            }
+        }
+
+        Body & Body::spillThreshold(const size_t size)
+        {
+            m_spillThreshold = size;
+            return *this;
+        }
+
+        size_t Body::spillThreshold() const
+        {
+            return m_spillThreshold;
+        }
+
+        bool Body::spilled() const
+        {
+            return m_file >= 0;
+        }
+
+        bool Body::failed() const
+        {
+            return m_failed;
+        }
+
+        Body & Body::operator =(const std::string & string)
+        {
+            clear();
+            return append(string.c_str(), string.size());
+        }
+
+        Body & Body::operator <<(const std::string & string)
+        {
+            return append(string.c_str(), string.size());
+        }
+
+        bool Body::spill()
+        {
+        #if defined(WEPP_PLATFORM_LINUX)
+            const char * directory = std::getenv("TMPDIR");
+            std::string path = std::string(directory && *directory ? directory : "/tmp") + "/wepp-body-XXXXXX";
+
+            m_file = ::mkostemp(&path[0], O_CLOEXEC);
+            if (m_file < 0)
+            {
+                return false;
+            }
+
+            // Unlinked right away, the file is removed when closed.
+            ::unlink(path.c_str());
+
+            if (!writeFile(m_data.data(), m_data.size()))
+            {
+                closeFile();
+                return false;
+            }
+
+            std::vector<char>().swap(m_data);
+            return true;
+        #else
+            return false;
+        #endif
+        }
+
+        bool Body::writeFile(const char * data, const size_t size)
+        {
+        #if defined(WEPP_PLATFORM_LINUX)
+            size_t written = 0;
+            while (written < size)
+            {
+                const ssize_t result = ::pwrite(m_file, data + written, size - written, static_cast<off_t>(m_fileSize + written));
+                if (result < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    return false;
+                }
+                written += static_cast<size_t>(result);
+            }
+
+            m_fileSize += size;
+            return true;
+        #else
+            (void)data;
+            (void)size;
+            return false;
+        #endif
+        }
+
+        void Body::closeFile()
+        {
+        #if defined(WEPP_PLATFORM_LINUX)
+            unmap();
+            if (m_file >= 0)
+            {
+                ::close(m_file);
+            }
+        #endif
+            m_file = -1;
+            m_fileSize = 0;
+        }
+
+        void Body::unmap() const
+        {
+        #if defined(WEPP_PLATFORM_LINUX)
+            if (m_map)
+            {
+                ::munmap(m_map, m_mapSize);
+            }
+        #endif
+            m_map = nullptr;
+            m_mapSize = 0;
+        }
+
+    }
+
+}
@@ -0,0 +1,269 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include "wepp/http/chunkedDecoder.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace Wepp
+{
+
+    namespace Http
+    {
+
+        namespace
+        {
+
+            inline int hexValue(const char c)
+            {
+                if (c >= '0' && c <= '9')
+                {
+                    return c - '0';
+                }
+                if (c >= 'a' && c <= 'f')
+                {
+                    return c - 'a' + 10;
+                }
+                if (c >= 'A' && c <= 'F')
+                {
+                    return c - 'A' + 10;
+                }
+                return -1;
+            }
+
+        }
+
+        ChunkedDecoder::ChunkedDecoder(const uint64_t limitBodySize, const size_t limitLine) :
+            m_limitBodySize(limitBodySize),
+            m_limitLine(limitLine)
+        {
+            reset();
+        }
+
+        void ChunkedDecoder::reset()
+        {
+            m_state = State::SizeStart;
+            m_error = Status::BadRequest;
+            m_chunkRemaining = 0;
+            m_bodySize = 0;
+            m_lineLength = 0;
+        }
+
+        ChunkedDecoder::Result ChunkedDecoder::execute(const char * data, const size_t size, size_t & consumed, StringView & chunk)
+        {
+            consumed = 0;
+            if (m_state == State::Complete)
+            {
+                return Result::Complete;
+            }
+            if (m_state == State::Error)
+            {
+                return Result::Error;
+            }
+
+            size_t i = 0;
+
+            while (i < size)
+            {
+                const char c = data[i];
+
+                // Data is returned directly, all other states are decoded byte by byte.
+                if (m_state == State::Data)
+                {
+                    const size_t length = static_cast<size_t>(std::min<uint64_t>(m_chunkRemaining, size - i));
+                    chunk = StringView(data + i, length);
+                    m_chunkRemaining -= length;
+                    if (!m_chunkRemaining)
+                    {
+                        m_state = State::DataEnd;
+                    }
+                    consumed = i + length;
+                    return Result::Data;
+                }
+
+                i++;
+                if (m_state < State::Data || (m_state >= State::TrailerLineStart && m_state <= State::TrailerLineEnd))
+                {
+                    if (++m_lineLength > m_limitLine + 2)
+                    {
+                        return fail(m_state < State::Data ? Status::BadRequest : Status::RequestHeaderFieldsTooLarge);
+                    }
+                }
+
+                switch (m_state)
+                {
+                    case State::SizeStart:
+                    {
+                        const int value = hexValue(c);
+                        if (value < 0)
+                        {
+                            return fail(Status::BadRequest);
+                        }
+                        m_chunkRemaining = static_cast<uint64_t>(value);
+                        m_state = State::Size;
+                    }
+                    break;
+                    case State::Size:
+                    {
+                        const int value = hexValue(c);
+                        if (value >= 0)
+                        {
+                            if (m_chunkRemaining > (std::numeric_limits<uint64_t>::max() >> 4))
+                            {
+                                return fail(Status::PayloadTooLarge);
+                            }
+                            m_chunkRemaining = (m_chunkRemaining << 4) | static_cast<uint64_t>(value);
+                            break;
+                        }
+                        if (m_chunkRemaining > m_limitBodySize - m_bodySize)
+                        {
+                            return fail(Status::PayloadTooLarge);
+                        }
+                        if (c == ';' || c == ' ' || c == '\t')
+                        {
+                            m_state = State::Extension;
+                        }
+                        else if (c == '\r')
+                        {
+                            m_state = State::SizeLineEnd;
+                        }
+                        else
+                        {
+                            return fail(Status::BadRequest);
+                        }
+                    }
+                    break;
+                    case State::Extension:
+                    {
+                        if (c == '\r')
+                        {
+                            m_state = State::SizeLineEnd;
+                        }
+                        else if ((static_cast<unsigned char>(c) < 0x20 && c != '\t') || c == 0x7F)
+                        {
+                            return fail(Status::BadRequest);
+                        }
+                    }
+                    break;
+                    case State::SizeLineEnd:
+                    {
+                        if (c != '\n')
+                        {
+                            return fail(Status::BadRequest);
+                        }
+                        m_lineLength = 0;
+                        m_bodySize += m_chunkRemaining;
+                        m_state = m_chunkRemaining ? State::Data : State::TrailerLineStart;
+                    }
+                    break;
+                    case State::DataEnd:
+                    {
+                        if (c != '\r')
+                        {
+                            return fail(Status::BadRequest);
+                        }
+                        m_state = State::DataLineEnd;
+                    }
+                    break;
+                    case State::DataLineEnd:
+                    {
+                        if (c != '\n')
+                        {
+                            return fail(Status::BadRequest);
+                        }
+                        m_state = State::SizeStart;
+                    }
+                    break;
+                    case State::TrailerLineStart:
+                    {
+                        m_state = c == '\r' ? State::LastLineEnd : State::TrailerLine;
+                        if (c == '\n')
+                        {
+                            return fail(Status::BadRequest);
+                        }
+                    }
+                    break;
+                    case State::TrailerLine:
+                    {
+                        if (c == '\r')
+                        {
+                            m_state = State::TrailerLineEnd;
+                        }
+                        else if ((static_cast<unsigned char>(c) < 0x20 && c != '\t') || c == 0x7F)
+                        {
+                            return fail(Status::BadRequest);
+                        }
+                    }
+                    break;
+                    case State::TrailerLineEnd:
+                    {
+                        if (c != '\n')
+                        {
+                            return fail(Status::BadRequest);
+                        }
+                        m_lineLength = 0;
+                        m_state = State::TrailerLineStart;
+                    }
+                    break;
+                    case State::LastLineEnd:
+                    {
+                        if (c != '\n')
+                        {
+                            return fail(Status::BadRequest);
+                        }
+                        m_state = State::Complete;
+                        consumed = i;
+                        return Result::Complete;
+                    }
+                    break;
+                    default:
+                        return fail(Status::InternalServerError);
+                }
+            }
+
+            consumed = size;
+            return Result::NeedMore;
+        }
+
+        Status ChunkedDecoder::error() const
+        {
+            return m_error;
+        }
+
+        uint64_t ChunkedDecoder::bodySize() const
+        {
+            return m_bodySize;
+        }
+
+        ChunkedDecoder::Result ChunkedDecoder::fail(const Status status)
+        {
+            m_state = State::Error;
+            m_error = status;
+            return Result::Error;
+        }
+
+    }
+
+}
@@ -0,0 +1,94 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include "wepp/http/header.hpp"
+#include <algorithm>
+
+namespace Wepp
+{
+
+    namespace Http
+    {
+
+        static const std::string s_headerStrings[] =
+        {
+            "accept", "accept-encoding", "accept-language", "authorization", "cache-control", "connection",
+            "content-encoding", "content-length", "content-type", "cookie", "date", "expect", "host",
+            "if-modified-since", "if-none-match", "last-modified", "location", "origin", "range", "referer",
+            "server", "set-cookie", "transfer-encoding", "upgrade", "user-agent", "x-forwarded-for", ""
+        };
+
+        static const size_t s_headerCount = static_cast<size_t>(HeaderId::Unknown);
+
+        // Ids of well-known header fields, bucketed by length of name.
+        struct HeaderLengthTable
+        {
+            static const size_t maxLength = 32;
+            static const size_t maxBucketSize = 8;
+
+            HeaderLengthTable() :
+                counts{}
+            {
+                for (size_t i = 0; i < s_headerCount; i++)
+                {
+                    const size_t length = s_headerStrings[i].size();
+                    ids[length][counts[length]++] = static_cast<HeaderId>(i);
+                }
+            }
+
+            HeaderId ids[maxLength][maxBucketSize];
+            uint8_t counts[maxLength];
+        };
+
+        static const HeaderLengthTable s_headerLengthTable;
+
+        const std::string & getHeaderAsString(const HeaderId id)
+        {
+            return s_headerStrings[std::min(static_cast<size_t>(id), s_headerCount)];
+        }
+
+        HeaderId getHeaderId(const StringView & name)
+        {
+            if (name.size() >= HeaderLengthTable::maxLength)
+            {
+                return HeaderId::Unknown;
+            }
+
+            const HeaderId * ids = s_headerLengthTable.ids[name.size()];
+            const uint8_t count = s_headerLengthTable.counts[name.size()];
+            for (uint8_t i = 0; i < count; i++)
+            {
+                if (name.equalsIgnoreCase(s_headerStrings[static_cast<size_t>(ids[i])]))
+                {
+                    return ids[i];
+                }
+            }
+
+            return HeaderId::Unknown;
+        }
+
+    }
+
+}
@@ -0,0 +1,463 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include "wepp/http/httpParser.hpp"
+#include "wepp/priv/byteScan.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace Wepp
+{
+
+    namespace Http
+    {
+
+        namespace
+        {
+
+            // Character classes, see: https://tools.ietf.org/html/rfc7230#section-3.2.6
+            // Request target, version and field values are scanned for control bytes by Priv::findControl.
+            enum CharClass : uint8_t
+            {
+                Token       = 0x01, /**< tchar */
+                Whitespace  = 0x02, /**< SP or HTAB */
+                Digit       = 0x04  /**< DIGIT */
+            };
+
+            struct CharTable
+            {
+                CharTable()
+                {
+                    static const char s_tokenSymbols[] = "!#$%&'*+-.^_`|~";
+
+                    for (size_t i = 0; i < 256; i++)
+                    {
+                        uint8_t value = 0;
+                        if ((i >= '0' && i <= '9') || (i >= 'a' && i <= 'z') || (i >= 'A' && i <= 'Z') ||
+                            std::find(s_tokenSymbols, s_tokenSymbols + sizeof(s_tokenSymbols) - 1, static_cast<char>(i)) != s_tokenSymbols + sizeof(s_tokenSymbols) - 1)
+                        {
+                            value |= Token;
+                        }
+                        if (i == ' ' || i == '\t')
+                        {
+                            value |= Whitespace;
+                        }
+                        if (i >= '0' && i <= '9')
+                        {
+                            value |= Digit;
+                        }
+                        classes[i] = value;
+                    }
+                }
+
+                uint8_t classes[256];
+            };
+
+            static const CharTable s_charTable;
+
+            inline uint8_t charClass(const char c)
+            {
+                return s_charTable.classes[static_cast<unsigned char>(c)];
+            }
+
+            inline size_t scan(const char * data, size_t position, const size_t size, const uint8_t classes)
+            {
+                while (position < size && (charClass(data[position]) & classes))
+                {
+                    position++;
+                }
+                return position;
+            }
+
+        }
+
+        HttpParser::HttpParser(const size_t limitRequestLine, const size_t limitHeaderFieldLine,
+                               const size_t limitHeaderFieldCount) :
+            m_limitRequestLine(std::max<size_t>(limitRequestLine, 16)),
+            m_limitHeaderFieldLine(std::max<size_t>(limitHeaderFieldLine, 8)),
+            m_limitHeaderFieldCount(limitHeaderFieldCount)
+        {
+            reset();
+        }
+
+        void HttpParser::reset()
+        {
+            m_state = State::Method;
+            m_error = Status::BadRequest;
+            m_position = 0;
+            m_tokenEnd = 0;
+            m_valueStart = 0;
+            m_valueEnd = 0;
+            m_headerCount = 0;
+            m_contentLength = 0;
+            m_foundContentLength = false;
+            m_chunked = false;
+        }
+
+        HttpParser::Result HttpParser::execute(const char * data, const size_t size, size_t & consumed, Request & request)
+        {
+            consumed = 0;
+            if (m_state == State::Complete)
+            {
+                return Result::Complete;
+            }
+            if (m_state == State::Error)
+            {
+                return Result::Error;
+            }
+
+            // Positions are relative to the current line, lineSize being the number of bytes from line to end of data.
+            const char * line = data;
+            size_t lineSize = size;
+            size_t i = m_position;
+
+            while (i < lineSize)
+            {
+                switch (m_state)
+                {
+                    case State::Method:
+                    {
+                        i = scan(line, i, lineSize, Token);
+                        if (i == lineSize)
+                        {
+                            break;
+                        }
+                        if (line[i] != ' ' || i == 0)
+                        {
+                            return fail(Status::BadRequest);
+                        }
+                        m_tokenEnd = i++;
+                        m_state = State::Resource;
+                    }
+                    break;
+                    case State::Resource:
+                    {
+                        i = static_cast<size_t>(Priv::findControl(line + i, line + lineSize, ' ') - line);
+                        if (i == lineSize)
+                        {
+                            break;
+                        }
+                        if (line[i] != ' ' || i == m_tokenEnd + 1)
+                        {
+                            return fail(Status::BadRequest);
+                        }
+                        m_valueEnd = i++;
+                        m_valueStart = i;
+                        m_state = State::Version;
+                    }
+                    break;
+                    case State::Version:
+                    {
+                        i = static_cast<size_t>(Priv::findControl(line + i, line + lineSize, ' ') - line);
+                        if (i == lineSize)
+                        {
+                            break;
+                        }
+                        if (line[i] != '\r')
+                        {
+                            return fail(Status::BadRequest);
+                        }
+                        i++;
+                        m_state = State::RequestLineEnd;
+                    }
+                    break;
+                    case State::RequestLineEnd:
+                    {
+                        if (line[i] != '\n')
+                        {
+                            return fail(Status::BadRequest);
+                        }
+                        if (i - 1 > m_limitRequestLine)
+                        {
+                            return fail(Status::UriTooLong);
+                        }
+                        if (!commitRequestLine(line, i - 1, request))
+                        {
+                            return Result::Error;
+                        }
+
+                        m_state = State::HeaderLineStart;
+                        m_position = 0;
+                        consumed = static_cast<size_t>(line - data) + i + 1;
+                        return Result::RequestLine;
+                    }
+                    break;
+                    case State::HeaderLineStart:
+                    {
+                        if (line[i] == '\r')
+                        {
+                            m_state = State::HeadersEnd;
+                        }
+                        else if (charClass(line[i]) & Token)
+                        {
+                            m_state = State::HeaderName;
+                        }
+                        else
+                        {
+                            return fail(Status::BadRequest);
+                        }
+                        i++;
+                    }
+                    break;
+                    case State::HeaderName:
+                    {
+                        // Whitespace between field name and colon is not allowed.
+                        // See: https://tools.ietf.org/html/rfc7230#section-3.2.4
+                        i = scan(line, i, lineSize, Token);
+                        if (i == lineSize)
+                        {
+                            break;
+                        }
+                        if (line[i] != ':')
+                        {
+                            return fail(Status::BadRequest);
+                        }
+                        m_tokenEnd = i++;
+                        m_state = State::HeaderValueStart;
+                    }
+                    break;
+                    case State::HeaderValueStart:
+                    {
+                        i = scan(line, i, lineSize, Whitespace);
+                        if (i == lineSize)
+                        {
+                            break;
+                        }
+                        m_valueStart = i;
+                        m_valueEnd = i;
+                        m_state = State::HeaderValue;
+                    }
+                    break;
+                    case State::HeaderValue:
+                    {
+                        // Skip to next control byte, tab included, and trim trailing whitespace of the skipped bytes.
+                        while (true)
+                        {
+                            const size_t next = static_cast<size_t>(Priv::findControl(line + i, line + lineSize, 0x1F) - line);
+                            size_t valueEnd = next;
+                            while (valueEnd > i && (charClass(line[valueEnd - 1]) & Whitespace))
+                            {
+                                valueEnd--;
+                            }
+                            if (valueEnd > i)
+                            {
+                                m_valueEnd = valueEnd;
+                            }
+
+                            i = next;
+                            if (i == lineSize || line[i] != '\t')
+                            {
+                                break;
+                            }
+                            i++;
+                        }
+                        if (i == lineSize)
+                        {
+                            break;
+                        }
+                        if (line[i] != '\r')
+                        {
+                            return fail(Status::BadRequest);
+                        }
+                        i++;
+                        m_state = State::HeaderLineEnd;
+                    }
+                    break;
+                    case State::HeaderLineEnd:
+                    {
+                        if (line[i] != '\n')
+                        {
+                            return fail(Status::BadRequest);
+                        }
+                        if (i - 1 > m_limitHeaderFieldLine)
+                        {
+                            return fail(Status::RequestHeaderFieldsTooLarge);
+                        }
+                        if (!commitHeader(line, request))
+                        {
+                            return Result::Error;
+                        }
+
+                        line += i + 1;
+                        lineSize -= i + 1;
+                        i = 0;
+                        m_state = State::HeaderLineStart;
+                    }
+                    break;
+                    case State::HeadersEnd:
+                    {
+                        if (line[i] != '\n')
+                        {
+                            return fail(Status::BadRequest);
+                        }
+
+                        // Content-length together with transfer-encoding may be used for request smuggling.
+                        // See: https://tools.ietf.org/html/rfc7230#section-3.3.3
+                        if (m_chunked && m_foundContentLength)
+                        {
+                            return fail(Status::BadRequest);
+                        }
+
+                        m_state = State::Complete;
+                        m_position = 0;
+                        consumed = static_cast<size_t>(line - data) + i + 1;
+                        return Result::Complete;
+                    }
+                    break;
+                    default:
+                        return fail(Status::InternalServerError);
+                }
+            }
+
+            // Reject partial lines as soon as they exceed the limit, CR included.
+            const size_t lineLength = size - static_cast<size_t>(line - data);
+            if (m_state < State::HeaderLineStart)
+            {
+                if (lineLength > m_limitRequestLine + 1)
+                {
+                    return fail(Status::UriTooLong);
+                }
+            }
+            else if (lineLength > m_limitHeaderFieldLine + 1)
+            {
+                return fail(Status::RequestHeaderFieldsTooLarge);
+            }
+
+            m_position = lineLength;
+            consumed = static_cast<size_t>(line - data);
+            return Result::NeedMore;
+        }
+
+        Status HttpParser::error() const
+        {
+            return m_error;
+        }
+
+        size_t HttpParser::contentLength() const
+        {
+            return m_contentLength;
+        }
+
+        bool HttpParser::chunked() const
+        {
+            return m_chunked;
+        }
+
+        HttpParser::Result HttpParser::fail(const Status status)
+        {
+            m_state = State::Error;
+            m_error = status;
+            return Result::Error;
+        }
+
+        bool HttpParser::commitRequestLine(const char * line, const size_t lineLength, Request & request)
+        {
+            static const char s_version[] = "HTTP/1.1";
+            static const size_t s_versionLength = sizeof(s_version) - 1;
+
+            const size_t versionLength = lineLength - m_valueStart;
+            if (versionLength != s_versionLength || !std::equal(s_version, s_version + s_versionLength, line + m_valueStart))
+            {
+                fail(Status::HttpVersionNotSupported);
+                return false;
+            }
+
+            request.methodView(StringView(line, m_tokenEnd));
+            request.resourceView(StringView(line + m_tokenEnd + 1, m_valueEnd - m_tokenEnd - 1));
+            request.versionView(StringView(line + m_valueStart, versionLength));
+            return true;
+        }
+
+        bool HttpParser::commitHeader(const char * line, Request & request)
+        {
+            if (m_headerCount >= m_limitHeaderFieldCount)
+            {
+                fail(Status::BadRequest);
+                return false;
+            }
+
+            const char * value = line + m_valueStart;
+            const size_t valueLength = m_valueEnd - m_valueStart;
+
+            // Parse content-length.
+            const StringView name(line, m_tokenEnd);
+            const HeaderId id = getHeaderId(name);
+            if (id == HeaderId::ContentLength)
+            {
+                if (valueLength == 0)
+                {
+                    fail(Status::BadRequest);
+                    return false;
+                }
+
+                size_t contentLength = 0;
+                for (size_t i = 0; i < valueLength; i++)
+                {
+                    const size_t digit = static_cast<size_t>(value[i] - '0');
+                    if (!(charClass(value[i]) & Digit) ||
+                        contentLength > (std::numeric_limits<size_t>::max() - digit) / 10)
+                    {
+                        fail(Status::BadRequest);
+                        return false;
+                    }
+                    contentLength = (contentLength * 10) + digit;
+                }
+
+                // Do not allow multiple content-length fields with different values.
+                if (m_foundContentLength && m_contentLength != contentLength)
+                {
+                    fail(Status::BadRequest);
+                    return false;
+                }
+
+                m_contentLength = contentLength;
+                m_foundContentLength = true;
+            }
+            // Only chunked transfer coding is supported, without any other coding applied.
+            // See: https://tools.ietf.org/html/rfc7230#section-3.3.1
+            else if (id == HeaderId::TransferEncoding)
+            {
+                if (m_chunked)
+                {
+                    fail(Status::BadRequest);
+                    return false;
+                }
+                if (!StringView(value, valueLength).equalsIgnoreCase("chunked"))
+                {
+                    fail(Status::NotImplemented);
+                    return false;
+                }
+
+                m_chunked = true;
+            }
+
+            request.addHeaderView(id, name, StringView(value, valueLength));
+            m_headerCount++;
+            return true;
+        }
+
+    }
+
+}
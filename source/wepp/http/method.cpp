@@ -33,14 +33,42 @@ namespace Wepp
 
         static const std::string s_methodStrings[] =
         {
-            "GET", "HEAD", "POST", "PUT", "DELETE", "TRACE", "OPTION", "CONNECT", "PATCH"
+            "GET", "HEAD", "POST", "PUT", "DELETE", "TRACE", "OPTION", "CONNECT", "PATCH", ""
         };
 
+        // Perfect hash of the first two bytes of method names, see hashMethod.
+        static const int s_methodHashTable[16] =
+        {
+            7, 3, -1, 2, -1, 4, 0, -1, -1, 1, -1, -1, -1, 8, 5, 6
+        };
+
+        static size_t hashMethod(const StringView & name)
+        {
+            return (static_cast<unsigned char>(name[0]) ^ (static_cast<unsigned char>(name[1]) * 13u)) & 15u;
+        }
+
         const std::string & getMethodAsString(const Method method)
         {
             return s_methodStrings[static_cast<size_t>(method)];
         }
 
+        bool parseMethod(const StringView & name, Method & method)
+        {
+            if (name.size() < 2)
+            {
+                return false;
+            }
+
+            const int index = s_methodHashTable[hashMethod(name)];
+            if (index < 0 || name != StringView(s_methodStrings[index]))
+            {
+                return false;
+            }
+
+            method = static_cast<Method>(index);
+            return true;
+        }
+
     }
 
 }
\ No newline at end of file
@@ -24,6 +24,7 @@
 */
 
 #include "wepp/http/request.hpp"
+#include <algorithm>
 
 namespace Wepp
 {
@@ -34,31 +35,39 @@ namespace Wepp
         Request::Request() :
             m_method(""),
             m_resource(""),
-            m_version("HTTP/1.1")
+            m_version("HTTP/1.1"),
+            m_methodOwned(true),
+            m_resourceOwned(true),
+            m_versionOwned(true)
         { }
 
         const std::string & Request::method() const
         {
+            materializeMethod();
             return m_method;
         }
 
         const std::string & Request::resource() const
         {
+            materializeResource();
             return m_resource;
         }
 
         const std::string & Request::version() const
         {
+            materializeVersion();
             return m_version;
         }
 
         Request::HeaderMap & Request::headers()
         {
+            materializeHeaders();
             return m_headers;
         }
 
         const Request::HeaderMap & Request::headers() const
         {
+            materializeHeaders();
             return m_headers;
         }
 
@@ -72,8 +81,58 @@ namespace Wepp
             return m_body;
         }
 
+        StringView Request::methodView() const
+        {
+            return m_methodOwned ? StringView(m_method) : m_methodView;
+        }
+
+        StringView Request::resourceView() const
+        {
+            return m_resourceOwned ? StringView(m_resource) : m_resourceView;
+        }
+
+        StringView Request::versionView() const
+        {
+            return m_versionOwned ? StringView(m_version) : m_versionView;
+        }
+
+        StringView Request::header(const StringView & name) const
+        {
+            auto view = m_headerViews.find(name);
+            if (view != m_headerViews.end())
+            {
+                return view->second;
+            }
+
+            auto it = m_headers.find(name);
+            return it != m_headers.end() ? StringView(it->second) : StringView();
+        }
+
+        StringView Request::header(const HeaderId id) const
+        {
+            auto view = m_headerViews.find(id);
+            if (view != m_headerViews.end())
+            {
+                return view->second;
+            }
+
+            auto it = m_headers.find(id);
+            return it != m_headers.end() ? StringView(it->second) : StringView();
+        }
+
+        bool Request::hasHeader(const StringView & name) const
+        {
+            return m_headerViews.find(name) != m_headerViews.end() || m_headers.find(name) != m_headers.end();
+        }
+
+        bool Request::hasHeader(const HeaderId id) const
+        {
+            return m_headerViews.find(id) != m_headerViews.end() || m_headers.find(id) != m_headers.end();
+        }
+
         Request & Request::method(const std::string & method)
         {
+            m_methodOwned = true;
             m_method = method;
             std::transform(m_method.begin(), m_method.end(), m_method.begin(), [](int c) -> char {return static_cast<char>(::toupper(c)); });
             return *this;
@@ -81,16 +140,114 @@ namespace Wepp
 
         Request & Request::resource(const std::string & resource)
         {
+            m_resourceOwned = true;
             m_resource = resource;
             return *this;
         }
 
         Request & Request::version(const std::string & version)
         {
+            m_versionOwned = true;
             m_version = version;
             return *this;
         }
 
+        Request & Request::methodView(const StringView & method)
+        {
+            m_methodOwned = false;
+            m_methodView = method;
+            return *this;
+        }
+
+        Request & Request::resourceView(const StringView & resource)
+        {
+            m_resourceOwned = false;
+            m_resourceView = resource;
+            return *this;
+        }
+
+        Request & Request::versionView(const StringView & version)
+        {
+            m_versionOwned = false;
+            m_versionView = version;
+            return *this;
+        }
+
+        Request & Request::addHeaderView(const StringView & name, const StringView & value)
+        {
+            m_headerViews.add(name, value);
+            return *this;
+        }
+
+        Request & Request::addHeaderView(const HeaderId id, const StringView & name, const StringView & value)
+        {
+            m_headerViews.add(id, name, value);
+            return *this;
+        }
+
+        void Request::materialize() const
+        {
+            materializeMethod();
+            materializeResource();
+            materializeVersion();
+            materializeHeaders();
+        }
+
+        void Request::reset()
+        {
+            m_method.clear();
+            m_resource.clear();
+            m_version.assign("HTTP/1.1");
+            m_headers.clear();
+            m_body.clear();
+            m_body.spillThreshold(0);
+
+            m_methodView = StringView();
+            m_resourceView = StringView();
+            m_versionView = StringView();
+            m_headerViews.clear();
+            m_methodOwned = true;
+            m_resourceOwned = true;
+            m_versionOwned = true;
+        }
+
+        void Request::materializeMethod() const
+        {
+            if (!m_methodOwned)
+            {
+                m_method = m_methodView.str();
+                std::transform(m_method.begin(), m_method.end(), m_method.begin(), [](int c) -> char {return static_cast<char>(::toupper(c)); });
+                m_methodOwned = true;
+            }
+        }
+
+        void Request::materializeResource() const
+        {
+            if (!m_resourceOwned)
+            {
+                m_resource = m_resourceView.str();
+                m_resourceOwned = true;
+            }
+        }
+
+        void Request::materializeVersion() const
+        {
+            if (!m_versionOwned)
+            {
+                m_version = m_versionView.str();
+                m_versionOwned = true;
+            }
+        }
+
+        void Request::materializeHeaders() const
+        {
+            for (auto & field : m_headerViews)
+            {
+                m_headers.add(field.id, field.first.str(), field.second.str());
+            }
+            m_headerViews.clear();
+        }
+
     }
 
 }
\ No newline at end of file
@@ -46,6 +46,40 @@ namespace Wepp
             return *this;
         }
 
+        HeaderMap & Response::headers()
+        {
+            return m_headers;
+        }
+
+        const HeaderMap & Response::headers() const
+        {
+            return m_headers;
+        }
+
+        Response & Response::header(const std::string & name, const std::string & value)
+        {
+            m_headers.set(name, value);
+            return *this;
+        }
+
+        Response & Response::header(const HeaderId id, const StringView & value)
+        {
+            if (id == HeaderId::Unknown)
+            {
+                return *this;
+            }
+
+            auto it = m_headers.find(id);
+            if (it == m_headers.end())
+            {
+                m_headers.add(id, getHeaderAsString(id), value.str());
+                return *this;
+            }
+
+            it->second.assign(value.data(), value.size());
+            return *this;
+        }
+
         const Body & Response::body() const
         {
             return m_body;
@@ -62,6 +96,13 @@ namespace Wepp
             return *this;
         }
 
+        void Response::reset()
+        {
+            m_status = Status::Ok;
+            m_headers.clear();
+            m_body.clear();
+        }
+
     }
 
 }
\ No newline at end of file
@@ -24,10 +24,14 @@
 */
 
 #include "wepp/http/router.hpp"
+#include "wepp/priv/routeScan.hpp"
 #include <algorithm>
+#include <stdexcept>
 #include <regex>
-#include <set>
-#include <memory>
+#include <cstring>
+#include <queue>
+#include <list>
+#include <unordered_map>
 
 namespace Wepp
 {
@@ -36,64 +40,767 @@ namespace Wepp
     {
 
         static const Router::CallbackFunc s_defaultCallbackFunc = nullptr;
+        static const size_t s_methodCount = static_cast<size_t>(Method::Custom);
+
+        static std::string toUpper(const StringView & string)
+        {
+            std::string result = string.str();
+            std::transform(result.begin(), result.end(), result.begin(), [](int c) -> char {return static_cast<char>(::toupper(c)); });
+            return result;
+        }
+
+        // Finds value of method, indexed by enumerator for known methods. Names of known methods are parsed without copying.
+        template<typename Value>
+        static const Value * findMethod(const Value (&methods)[s_methodCount], const std::map<std::string, Value> & customMethods, const StringView & name)
+        {
+            Method method;
+            if (parseMethod(name, method))
+            {
+                return &methods[static_cast<size_t>(method)];
+            }
+
+            const std::string upperName = toUpper(name);
+            if (parseMethod(upperName, method))
+            {
+                return &methods[static_cast<size_t>(method)];
+            }
+
+            auto it = customMethods.find(upperName);
+            return it != customMethods.end() ? &it->second : nullptr;
+        }
+
+        // Splits path of route into directories. Tags may contain '/', and '\\' escapes the next character of a tag.
+        static std::vector<std::string> splitRoutePath(const std::string & path, bool & hasTags)
+        {
+            std::vector<std::string> dirs;
+            hasTags = false;
+            if (path.empty())
+            {
+                return dirs;
+            }
+
+            size_t i = path[0] == '/' ? 1 : 0;
+            std::string dir;
+            bool inTag = false;
+            for (; i < path.size(); i++)
+            {
+                char c = path[i];
+                if (inTag)
+                {
+                    if (c == '\\' && i + 1 < path.size())
+                    {
+                        dir += c;
+                        c = path[++i];
+                    }
+                    else if (c == '>')
+                    {
+                        inTag = false;
+                    }
+                }
+                else if (c == '<')
+                {
+                    inTag = true;
+                    hasTags = true;
+                }
+                else if (c == '/')
+                {
+                    dirs.push_back(dir);
+                    dir.clear();
+                    continue;
+                }
+                dir += c;
+            }
+            dirs.push_back(dir);
+            return dirs;
+        }
+
+        // Gets regex group of typed tag, for tags not spanning a whole directory.
+        static const char * getTypePattern(const RouteParameter::Type type)
+        {
+            switch (type)
+            {
+                case RouteParameter::Type::Int: return "(-?[0-9]+)";
+                case RouteParameter::Type::Uuid: return "([0-9A-Fa-f]{8}-[0-9A-Fa-f]{4}-[0-9A-Fa-f]{4}-[0-9A-Fa-f]{4}-[0-9A-Fa-f]{12})";
+                case RouteParameter::Type::Slug: return "([A-Za-z0-9_-]+)";
+                default: break;
+            }
+            return "(.*)";
+        }
+
+        // Gets rank of tag type, lower ranked tags are tried first.
+        static int getTypeRank(const RouteParameter::Type type)
+        {
+            switch (type)
+            {
+                case RouteParameter::Type::Int: return 0;
+                case RouteParameter::Type::Uuid: return 1;
+                case RouteParameter::Type::Slug: return 2;
+                case RouteParameter::Type::Path: return 4;
+                default: break;
+            }
+            return 3;
+        }
+
+        static void addCapture(std::vector<std::string> & matches, const StringView &, const RouteParameter::Type,
+                               const char * begin, const char * end, const int64_t)
+        {
+            matches.emplace_back(begin, end);
+        }
+
+        static void addCapture(std::vector<RouteParameter> & parameters, const StringView & name, const RouteParameter::Type type,
+                               const char * begin, const char * end, const int64_t integer)
+        {
+            parameters.push_back({ name.str(), type, std::string(begin, end), integer });
+        }
+
+        static void addCapture(RouteCaptures & captures, const StringView & name, const RouteParameter::Type type,
+                               const char * begin, const char * end, const int64_t integer)
+        {
+            captures.add(name, type, begin, end, integer);
+        }
+
+        template<typename Captures>
+        static void resetCaptures(Captures & captures, const char *)
+        {
+            captures.clear();
+        }
+
+        static void resetCaptures(RouteCaptures & captures, const char * path)
+        {
+            captures.reset(path);
+        }
+
+        // Tag matcher.
+        struct TagMatcher
+        {
+            struct Capture
+            {
+                std::string name;
+                RouteParameter::Type type;
+            };
+
+            TagMatcher(const std::string & dir);
+
+            template<typename Captures>
+            bool match(const char * begin, const char * end, Captures & captures) const;
+
+            RouteParameter::Type scanner;   /**< Type of tag spanning the whole directory, or Regex if matched by regex. */
+            std::vector<Capture> captures;  /**< Capture of each regex group, or of the scanner. */
+            std::regex regex;               /**< Regex of directory, tags replaced by groups. */
+        };
+
+        TagMatcher::TagMatcher(const std::string & dir) :
+            scanner(RouteParameter::Type::Regex)
+        {
+            // Replace tags with regex groups, empty tags matching anything.
+            std::string pattern;
+            size_t i = 0;
+            while (i < dir.size())
+            {
+                const size_t tagStart = dir.find('<', i);
+                pattern.append(dir, i, tagStart == std::string::npos ? std::string::npos : tagStart - i);
+                if (tagStart == std::string::npos)
+                {
+                    break;
+                }
+
+                const size_t tagEnd = static_cast<size_t>(Priv::findTagEnd(dir.data() + tagStart + 1, dir.data() + dir.size()) - dir.data());
+                const std::string tag = dir.substr(tagStart + 1, tagEnd - tagStart - 1);
+                Capture capture = { "", RouteParameter::Type::String };
+                StringView name;
+                if (tag.empty() || Priv::parseTypedTag(tag, name, capture.type))
+                {
+                    capture.name = name.str();
+                    if (tagStart == 0 && tagEnd + 1 >= dir.size())
+                    {
+                        // Tag is the whole directory, match by scanner.
+                        scanner = capture.type;
+                        captures.push_back(capture);
+                        return;
+                    }
+                    pattern += getTypePattern(capture.type);
+                    captures.push_back(capture);
+                }
+                else
+                {
+                    pattern += "(" + tag + ")";
+                    captures.push_back({ "", RouteParameter::Type::Regex });
+                    captures.resize(captures.size() + std::regex(tag).mark_count(), { "", RouteParameter::Type::Regex });
+                }
+                i = tagEnd + 1;
+            }
+
+            regex.assign(pattern);
+        }
+
+        template<typename Captures>
+        bool TagMatcher::match(const char * begin, const char * end, Captures & output) const
+        {
+            int64_t integer = 0;
+            if (scanner != RouteParameter::Type::Regex)
+            {
+                if (!Priv::scanRouteValue(scanner, begin, end, integer))
+                {
+                    return false;
+                }
+                addCapture(output, captures.front().name, scanner, begin, end, integer);
+                return true;
+            }
+
+            std::cmatch match;
+            if (!std::regex_search(begin, end, match, regex))
+            {
+                return false;
+            }
+
+            // Check integers before adding any capture, as conversion fails on overflow.
+            for (size_t i = 1; i < match.size() && i <= captures.size(); i++)
+            {
+                if (captures[i - 1].type == RouteParameter::Type::Int &&
+                    !Priv::scanRouteValue(RouteParameter::Type::Int, match[i].first, match[i].second, integer))
+                {
+                    return false;
+                }
+            }
+
+            static const Capture s_regexCapture = { "", RouteParameter::Type::Regex };
+            for (size_t i = 1; i < match.size(); i++)
+            {
+                const Capture & capture = i <= captures.size() ? captures[i - 1] : s_regexCapture;
+                integer = 0;
+                if (capture.type == RouteParameter::Type::Int)
+                {
+                    Priv::scanRouteValue(RouteParameter::Type::Int, match[i].first, match[i].second, integer);
+                }
+                addCapture(output, capture.name, capture.type, match[i].first, match[i].second, integer);
+            }
+            return true;
+        }
+
+        // Lookup cache of a compiled trie, split into shards of least recently used entries.
+        class RouteCache
+        {
+
+        public:
+
+            explicit RouteCache(const size_t capacity);
+
+            bool find(const StringView & path, const RouteCallback *& routeCallback, RouteCaptures & captures);
+            void insert(const StringView & path, const RouteCallback * routeCallback, const RouteCaptures & captures);
+            void addStatistics(Router::CacheStatistics & statistics) const;
+
+        private:
+
+            struct Entry
+            {
+                std::string path;
+                uint64_t hash;
+                const RouteCallback * routeCallback;
+                RouteCaptures captures;
+            };
+
+            struct Shard
+            {
+                mutable std::mutex mutex;
+                std::list<Entry> entries;                                       /**< Entries, most recently used first. */
+                std::unordered_map<uint64_t, std::list<Entry>::iterator> index; /**< Entries by hash of path. */
+                size_t capacity;                                                /**< Maximum number of entries. */
+                uint64_t hits;
+                uint64_t misses;
+                uint64_t evictions;
+            };
+
+            static const size_t s_shardCount = 16;
+
+            static uint64_t hash(const StringView & path);
+            Shard & shard(const uint64_t hash);
+
+            size_t m_shardCount;                /**< Number of used shards, at most the capacity. */
+            Shard m_shards[s_shardCount];       /**< Shards, selected by hash of path. */
+
+        };
+
+        const size_t RouteCache::s_shardCount;
+
+        RouteCache::RouteCache(const size_t capacity) :
+            m_shardCount(std::max<size_t>(std::min(capacity, s_shardCount), 1))
+        {
+            // The capacity is split over the used shards, so their total is exactly the capacity.
+            for (size_t i = 0; i < s_shardCount; i++)
+            {
+                auto & shard = m_shards[i];
+                shard.capacity = i < m_shardCount ? capacity / m_shardCount + (i < capacity % m_shardCount ? 1 : 0) : 0;
+                shard.hits = 0;
+                shard.misses = 0;
+                shard.evictions = 0;
+            }
+        }
+
+        bool RouteCache::find(const StringView & path, const RouteCallback *& routeCallback, RouteCaptures & captures)
+        {
+            const uint64_t pathHash = hash(path);
+            Shard & pathShard = shard(pathHash);
+            std::lock_guard<std::mutex> lock(pathShard.mutex);
+
+            auto it = pathShard.index.find(pathHash);
+            if (it == pathShard.index.end() || StringView(it->second->path) != path)
+            {
+                pathShard.misses++;
+                return false;
+            }
+
+            pathShard.hits++;
+            pathShard.entries.splice(pathShard.entries.begin(), pathShard.entries, it->second);
+            routeCallback = it->second->routeCallback;
+            captures = it->second->captures;
+            captures.rebase(path.data());
+            return true;
+        }
+
+        void RouteCache::insert(const StringView & path, const RouteCallback * routeCallback, const RouteCaptures & captures)
+        {
+            const uint64_t pathHash = hash(path);
+            Shard & pathShard = shard(pathHash);
+            std::lock_guard<std::mutex> lock(pathShard.mutex);
+
+            // Replace any entry of same hash, which may be another path.
+            auto it = pathShard.index.find(pathHash);
+            if (it != pathShard.index.end())
+            {
+                pathShard.entries.erase(it->second);
+                pathShard.index.erase(it);
+            }
+            else if (pathShard.entries.size() >= pathShard.capacity)
+            {
+                pathShard.index.erase(pathShard.entries.back().hash);
+                pathShard.entries.pop_back();
+                pathShard.evictions++;
+            }
+
+            pathShard.entries.push_front({ path.str(), pathHash, routeCallback, captures });
+            pathShard.index.insert({ pathHash, pathShard.entries.begin() });
+        }
+
+        void RouteCache::addStatistics(Router::CacheStatistics & statistics) const
+        {
+            for (auto & shard : m_shards)
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                statistics.hits += shard.hits;
+                statistics.misses += shard.misses;
+                statistics.evictions += shard.evictions;
+                statistics.size += shard.entries.size();
+            }
+        }
+
+        uint64_t RouteCache::hash(const StringView & path)
+        {
+            // FNV-1a.
+            uint64_t result = 14695981039346656037ULL;
+            for (const char c : path)
+            {
+                result = (result ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+            }
+            return result;
+        }
+
+        RouteCache::Shard & RouteCache::shard(const uint64_t hash)
+        {
+            return m_shards[(hash >> 32) % m_shardCount];
+        }
+
+        // Compiled trie of a route method, immutable once compiled.
+        class RouteTrie
+        {
+
+        public:
+
+            /**
+            * Node of trie.
+            * Children of a node are stored contiguously, static children first, sorted by their first directory.
+            *
+            */
+            struct Node
+            {
+                uint32_t prefix;                        /**< Offset of static prefix in prefixes. */
+                uint32_t prefixSize;                    /**< Size of static prefix, spanning one or more directories. */
+                uint32_t firstDirSize;                  /**< Size of first directory of static prefix. */
+                uint32_t childBegin;                    /**< Index of first child node. */
+                uint32_t staticCount;                   /**< Number of static children. */
+                uint32_t tagCount;                      /**< Number of tag children, following the static children. */
+                const TagMatcher * matcher;             /**< Matcher of tag node, nullptr for static nodes. */
+                const RouteCallback * routeCallback;    /**< Route of node, nullptr if not routed. */
+            };
+
+            /**
+            * Find route by path, using the cache if enabled.
+            *
+            */
+            template<typename Captures>
+            const RouteCallback * find(const StringView & path, Captures & captures) const;
+            const RouteCallback * find(const StringView & path, RouteCaptures & captures) const;
+
+            /**
+            * Find route by path in trie.
+            *
+            */
+            template<typename Captures>
+            const RouteCallback * lookup(const StringView & path, Captures & captures) const;
+
+            std::unique_ptr<RouteCache> cache;                          /**< Lookup cache, nullptr if disabled. */
+            std::vector<Node> nodes;                                    /**< Nodes, root node first. */
+            std::string prefixes;                                       /**< Static prefixes of nodes. */
+            std::vector<std::shared_ptr<const TagMatcher>> matchers;    /**< Matchers of tag nodes. */
+            std::vector<std::unique_ptr<RouteCallback>> callbacks;      /**< Copies of routed callbacks. */
+
+        };
+
+        template<typename Captures>
+        const RouteCallback * RouteTrie::find(const StringView & path, Captures & output) const
+        {
+            if (!cache)
+            {
+                return lookup(path, output);
+            }
+
+            // Convert cached captures, unless some may have been dropped.
+            RouteCaptures captures;
+            const RouteCallback * routeCallback = find(path, captures);
+            if (captures.size() == RouteCaptures::capacity)
+            {
+                return lookup(path, output);
+            }
+
+            resetCaptures(output, path.data());
+            for (size_t i = 0; i < captures.size(); i++)
+            {
+                addCapture(output, captures.name(i), captures.type(i), captures[i].begin(), captures[i].end(), captures.integer(i));
+            }
+            return routeCallback;
+        }
+
+        const RouteCallback * RouteTrie::find(const StringView & path, RouteCaptures & captures) const
+        {
+            const RouteCallback * routeCallback = nullptr;
+            if (!cache)
+            {
+                return lookup(path, captures);
+            }
+            if (cache->find(path, routeCallback, captures))
+            {
+                return routeCallback;
+            }
+
+            // Cache found routes only, captures must not have been dropped.
+            routeCallback = lookup(path, captures);
+            if (routeCallback && captures.size() < RouteCaptures::capacity)
+            {
+                cache->insert(path, routeCallback, captures);
+            }
+            return routeCallback;
+        }
+
+        template<typename Captures>
+        const RouteCallback * RouteTrie::lookup(const StringView & path, Captures & captures) const
+        {
+            resetCaptures(captures, path.data());
+
+            const Node * node = nodes.data();
+            if (path.empty())
+            {
+                return node->routeCallback;
+            }
+
+            const char * prefixData = prefixes.data();
+            const char * position = path.data() + (path[0] == '/' ? 1 : 0);
+            const char * end = path.data() + path.size();
+            while (true)
+            {
+                const char * dirEnd = static_cast<const char *>(std::memchr(position, '/', static_cast<size_t>(end - position)));
+                dirEnd = dirEnd ? dirEnd : end;
+                const size_t dirSize = static_cast<size_t>(dirEnd - position);
+
+                // Binary search static children by their first directory.
+                const Node * first = nodes.data() + node->childBegin;
+                const Node * last = first + node->staticCount;
+                const Node * child = std::lower_bound(first, last, dirSize, [&](const Node & trieNode, const size_t)
+                {
+                    const int result = std::memcmp(prefixData + trieNode.prefix, position, std::min<size_t>(trieNode.firstDirSize, dirSize));
+                    return result < 0 || (result == 0 && trieNode.firstDirSize < dirSize);
+                });
+
+                if (child != last && child->firstDirSize == dirSize &&
+                    std::memcmp(prefixData + child->prefix, position, dirSize) == 0)
+                {
+                    // Match remaining directories of merged prefix.
+                    const size_t rest = child->prefixSize - dirSize;
+                    if (rest)
+                    {
+                        if (static_cast<size_t>(end - dirEnd) < rest ||
+                            std::memcmp(prefixData + child->prefix + dirSize, dirEnd, rest) != 0 ||
+                            (dirEnd + rest != end && dirEnd[rest] != '/'))
+                        {
+                            break;
+                        }
+                        dirEnd += rest;
+                    }
+                }
+                else
+                {
+                    // Find tag node, path tags matching the rest of path.
+                    child = last;
+                    const Node * tagEnd = last + node->tagCount;
+                    for (; child != tagEnd; child++)
+                    {
+                        const bool restOfPath = child->matcher->scanner == RouteParameter::Type::Path;
+                        if (child->matcher->match(position, restOfPath ? end : dirEnd, captures))
+                        {
+                            dirEnd = restOfPath ? end : dirEnd;
+                            break;
+                        }
+                    }
+                    if (child == tagEnd)
+                    {
+                        break;
+                    }
+                }
+
+                node = child;
+                if (dirEnd == end)
+                {
+                    return node->routeCallback;
+                }
+                position = dirEnd + 1;
+            }
+
+            // Failed to find any route.
+            resetCaptures(captures, path.data());
+            return nullptr;
+        }
+
+        // Versions of published snapshots, shared by all routers, so a cached version identifies both router and snapshot.
+        static std::atomic<uint64_t> s_snapshotVersion(0);
+
+        // Snapshot last read by each thread, with the version it was published as.
+        // Not owning, so idle threads never keep replaced routes alive.
+        struct SnapshotCache
+        {
+            uint64_t version = 0;
+            std::weak_ptr<const Router::Snapshot> snapshot;
+        };
+        static thread_local SnapshotCache t_snapshotCache;
 
         // Route class.
-        Router::Router()
+        Router::Router() :
+            m_methods(),
+            m_snapshot(new Snapshot()),
+            m_version(s_snapshotVersion.fetch_add(1, std::memory_order_relaxed) + 1),
+            m_cacheCapacity(0)
         { }
 
         Router::~Router()
         {
-            for (auto it = m_methods.begin(); it != m_methods.end(); it++)
+            for (auto routeMethod : methods())
             {
-                delete it->second;
+                delete routeMethod;
             }
         }
 
         size_t Router::methodCount() const
         {
-            return m_methods.size();
+            return methods().size();
         }
 
         RouteMethod & Router::operator[](const Method method)
         {
-            return this->operator[](getMethodAsString(method).c_str());
+            if (method == Method::Custom)
+            {
+                throw std::invalid_argument("Custom methods are routed by name.");
+            }
+
+            RouteMethod *& routeMethod = m_methods[static_cast<size_t>(method)];
+            if (routeMethod == nullptr)
+            {
+                routeMethod = new RouteMethod(getMethodAsString(method));
+                routeMethod->m_cacheCapacity = m_cacheCapacity;
+            }
+            return *routeMethod;
         }
 
         RouteMethod & Router::operator[](const std::string & method)
         {
-            std::string methodName = method;
-            std::transform(methodName.begin(), methodName.end(), methodName.begin(), [](int c) -> char {return static_cast<char>(::toupper(c)); });
+            const std::string methodName = toUpper(method);
+
+            Method parsedMethod;
+            if (parseMethod(methodName, parsedMethod))
+            {
+                return this->operator[](parsedMethod);
+            }
 
-            auto it = m_methods.find(methodName);
-            if (it != m_methods.end())
+            auto it = m_customMethods.find(methodName);
+            if (it != m_customMethods.end())
             {
                 return *it->second;
             }
 
             RouteMethod * routeMethod = new RouteMethod(methodName);
-            m_methods.insert({ methodName, routeMethod });
+            routeMethod->m_cacheCapacity = m_cacheCapacity;
+            m_customMethods.insert({ methodName, routeMethod });
             return *routeMethod;
         }
 
         const Router::CallbackFunc & Router::find(const std::string & method, const std::string & path, std::vector<std::string> & matches) const
         {
-            auto it = m_methods.find(method);
-            if (it == m_methods.end())
+            const RouteCallback * route = findRoute(method, path, matches);
+            return route ? route->callback : s_defaultCallbackFunc;
+        }
+
+        const RouteCallback * Router::findRoute(const std::string & method, const std::string & path, std::vector<std::string> & matches) const
+        {
+            RouteMethod * const * routeMethod = findMethod(m_methods, m_customMethods, method);
+            return routeMethod && *routeMethod ? (*routeMethod)->findRoute(path, matches) : nullptr;
+        }
+
+        const RouteCallback * Router::findRoute(const std::string & method, const std::string & path, std::vector<RouteParameter> & parameters) const
+        {
+            RouteMethod * const * routeMethod = findMethod(m_methods, m_customMethods, method);
+            return routeMethod && *routeMethod ? (*routeMethod)->findRoute(path, parameters) : nullptr;
+        }
+
+        const RouteCallback * Router::findRoute(const std::string & method, const StringView & path, RouteCaptures & captures) const
+        {
+            RouteMethod * const * routeMethod = findMethod(m_methods, m_customMethods, method);
+            return routeMethod && *routeMethod ? (*routeMethod)->findRoute(path, captures) : nullptr;
+        }
+
+        std::vector<RouteMethod *> Router::methods() const
+        {
+            std::vector<RouteMethod *> result;
+            for (auto routeMethod : m_methods)
+            {
+                if (routeMethod)
+                {
+                    result.push_back(routeMethod);
+                }
+            }
+            for (auto & pair : m_customMethods)
+            {
+                result.push_back(pair.second);
+            }
+            return result;
+        }
+
+        void Router::cacheCapacity(const size_t capacity)
+        {
+            m_cacheCapacity = capacity;
+            for (auto routeMethod : methods())
+            {
+                routeMethod->m_cacheCapacity = capacity;
+                routeMethod->m_compiled = false;
+            }
+        }
+
+        size_t Router::cacheCapacity() const
+        {
+            return m_cacheCapacity;
+        }
+
+        Router::CacheStatistics Router::cacheStatistics() const
+        {
+            CacheStatistics statistics = { 0, 0, 0, 0 };
+            for (auto routeMethod : methods())
+            {
+                auto trie = routeMethod->trie();
+                if (trie->cache)
+                {
+                    trie->cache->addStatistics(statistics);
+                }
+            }
+            return statistics;
+        }
+
+        void Router::publish()
+        {
+            std::shared_ptr<Snapshot> snapshot(new Snapshot());
+            for (size_t i = 0; i < s_methodCount; i++)
+            {
+                if (m_methods[i])
+                {
+                    snapshot->m_methods[i] = m_methods[i]->trie();
+                }
+            }
+            for (auto & pair : m_customMethods)
+            {
+                snapshot->m_customMethods.insert({ pair.first, pair.second->trie() });
+            }
+
+            std::lock_guard<std::mutex> lock(m_snapshotMutex);
+            m_snapshot = std::move(snapshot);
+            m_version.store(s_snapshotVersion.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        std::shared_ptr<const Router::Snapshot> Router::snapshot() const
+        {
+            // The lock is only taken once a new version is published, or the snapshot of another router was read.
+            SnapshotCache & cache = t_snapshotCache;
+            if (cache.version == m_version.load(std::memory_order_acquire))
+            {
+                auto snapshot = cache.snapshot.lock();
+                if (snapshot)
+                {
+                    return snapshot;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(m_snapshotMutex);
+            cache.snapshot = m_snapshot;
+            cache.version = m_version.load(std::memory_order_relaxed);
+            return m_snapshot;
+        }
+
+        const RouteCallback * Router::Snapshot::findRoute(const StringView & method, const StringView & path, RouteCaptures & captures) const
+        {
+            const std::shared_ptr<const RouteTrie> * trie = findMethod(m_methods, m_customMethods, method);
+            if (trie == nullptr || *trie == nullptr)
+            {
+                captures.reset(path.data());
+                return nullptr;
+            }
+
+            return (*trie)->find(path, captures);
+        }
+
+        const RouteCallback * Router::Snapshot::findRoute(const Method method, const StringView & path, RouteCaptures & captures) const
+        {
+            const std::shared_ptr<const RouteTrie> * trie = method != Method::Custom ? &m_methods[static_cast<size_t>(method)] : nullptr;
+            if (trie == nullptr || *trie == nullptr)
             {
-                return s_defaultCallbackFunc;
+                captures.reset(path.data());
+                return nullptr;
             }
 
-            return it->second->find(path, matches);
+            return (*trie)->find(path, captures);
         }
 
 
         // Route method class.
+        struct RouteMethod::RouteNode
+        {
+            std::map<std::string, std::unique_ptr<RouteNode>> regularTree;
+            std::map<std::string, std::unique_ptr<RouteNode>> tagTree;
+            std::shared_ptr<const TagMatcher> matcher;
+            std::unique_ptr<RouteCallback> routeCallback;
+        };
+
         RouteMethod::~RouteMethod()
         {
         }
 
         RouteMethod::RouteMethod(const std::string & name) :
-            m_name(name)
+            m_name(name),
+            m_rootNode(new RouteNode()),
+            m_cacheCapacity(0),
+            m_compiled(false)
         { }
 
         const std::string & RouteMethod::name() const
@@ -103,25 +810,17 @@ namespace Wepp
 
         RouteCallback & RouteMethod::operator[](const std::string & path)
         {
-            std::vector<std::string> dirs;
-            std::regex findDirRegex(R"(/?((?:[^/]*<[^>]*>)*[^/]*)?)"); //R"((?:/?((?:[^/]*<[^>]*>)*)?([^/]*)))");
-            std::regex findTagRegex(R"(<(\\?.)*?>)");// R"(<[^>]*>)");
-            std::regex findTagDataRegex(R"(<((?:\\?.)*?)>)");
+            bool hasTags = false;
+            const std::vector<std::string> dirs = splitRoutePath(path, hasTags);
 
-            const char * iter = path.c_str();
-            for (std::cmatch m; *iter && std::regex_search(iter, m, findDirRegex); iter += m[0].length())
-            {
-                dirs.push_back(m[1].length() ? m[1] : m[2]);
-            }
-
-            RouteNode * currentNode = &m_rootNode;
+            RouteNode * currentNode = m_rootNode.get();
             for (auto const & dir : dirs)
             {
                 auto it = currentNode->regularTree.find(dir);
                 if (it != currentNode->regularTree.end())
                 {
                     // Found regular node, move to next dir.
-                    currentNode = it->second;
+                    currentNode = it->second.get();
                     continue;
                 }
 
@@ -129,157 +828,296 @@ namespace Wepp
                 if (it != currentNode->tagTree.end())
                 {
                     // Found tag key node, move to next dir.
-                    currentNode = it->second;
+                    currentNode = it->second.get();
                     continue;
                 }
 
-                // Insert new node, but first check if it's a regular or a tag node.
-                if (std::regex_search(dir, findTagRegex))
+                // Insert new node, compiling the matcher of tag nodes.
+                std::unique_ptr<RouteNode> newRouteNode(new RouteNode());
+                RouteNode * nextNode = newRouteNode.get();
+                const size_t tagStart = dir.find('<');
+                if (hasTags && tagStart != std::string::npos && dir.find('>', tagStart) != std::string::npos)
                 {
-                    std::unique_ptr<RouteNode> newRouteNode(new RouteNode());
-
-                    std::string tagRegexDir = dir;
-                    std::string tagDir = dir;
-                    size_t currSearchPos = 0;
-
-                    // Find all tags
-                    for (std::smatch match; std::regex_search(tagRegexDir, match, findTagDataRegex);tagRegexDir = match.suffix())
-                    {
-                        size_t matchLength = match.length();
-                        size_t matchPosition = match.position();
-                        std::string groupedMatch;
-
-                        if (match[1].str().size())
-                        {
-                            groupedMatch = "(" + match[1].str() + ")";
-                        }
-                        else
-                        {
-                            groupedMatch = "(.*)";
-                        }
-
-                        // Replace tag with regex
-                        tagDir.replace(matchPosition + currSearchPos, matchLength, groupedMatch);
-                        currSearchPos += groupedMatch.length() + match.prefix().length();
-                    }
-
-                    // Add new route to previous node.
-                    newRouteNode->dir = tagDir;
-                    currentNode->tagTree.insert({ dir, newRouteNode.get() });
-
-
-                    currentNode = newRouteNode.release();
-                    continue;
+                    newRouteNode->matcher.reset(new TagMatcher(dir));
+                    currentNode->tagTree.insert({ dir, std::move(newRouteNode) });
+                }
+                else
+                {
+                    currentNode->regularTree.insert({ dir, std::move(newRouteNode) });
                 }
 
-                // Insert regular node.
-                RouteNode * newRouteNode = new RouteNode();
-                newRouteNode->dir = dir;
-                currentNode->regularTree.insert({ dir, newRouteNode});
-                currentNode = newRouteNode;
+                currentNode = nextNode;
             }
 
             if (!currentNode->routeCallback)
             {
-                currentNode->routeCallback = new RouteCallback();
+                currentNode->routeCallback.reset(new RouteCallback());
+                currentNode->routeCallback->m_compiled = &m_compiled;
             }
 
+            m_compiled = false;
             return *(currentNode->routeCallback);
         }
 
         const Router::CallbackFunc & RouteMethod::find(const std::string & path, std::vector<std::string> & matches) const
         {
-            matches.clear();
+            const RouteCallback * route = findRoute(path, matches);
+            return route ? route->callback : s_defaultCallbackFunc;
+        }
 
-            std::vector<std::string> dirs;
-            std::regex findDirRegex(R"((?:/?([^/]*)))");
+        const RouteCallback * RouteMethod::findRoute(const std::string & path, std::vector<std::string> & matches) const
+        {
+            return trie()->find(path, matches);
+        }
+
+        const RouteCallback * RouteMethod::findRoute(const std::string & path, std::vector<RouteParameter> & parameters) const
+        {
+            return trie()->find(path, parameters);
+        }
+
+        const RouteCallback * RouteMethod::findRoute(const StringView & path, RouteCaptures & captures) const
+        {
+            return trie()->find(path, captures);
+        }
 
-            const char * iter = path.c_str();
-            for (std::cmatch m; *iter && std::regex_search(iter, m, findDirRegex); iter += m[0].length())
+        std::shared_ptr<const RouteTrie> RouteMethod::trie() const
+        {
+            if (m_compiled.load(std::memory_order_acquire))
             {
-                dirs.push_back(m[1]);
+                return std::atomic_load_explicit(&m_trie, std::memory_order_acquire);
             }
 
-            const RouteNode * currentNode = &m_rootNode;
-            for (auto const & dir : dirs)
+            std::lock_guard<std::mutex> lock(m_compileMutex);
+            if (m_compiled.load(std::memory_order_acquire))
             {
-                // Find regular dir and more to next one.
-                auto it = currentNode->regularTree.find(dir);
-                if (it != currentNode->regularTree.end())
+                return std::atomic_load_explicit(&m_trie, std::memory_order_acquire);
+            }
+
+            std::shared_ptr<RouteTrie> trie(new RouteTrie());
+            if (m_cacheCapacity)
+            {
+                trie->cache.reset(new RouteCache(m_cacheCapacity));
+            }
+            auto addNode = [&trie](const RouteNode & routeNode, const std::string & prefix, const size_t firstDirSize)
+            {
+                RouteTrie::Node trieNode;
+                trieNode.prefix = static_cast<uint32_t>(trie->prefixes.size());
+                trieNode.prefixSize = static_cast<uint32_t>(prefix.size());
+                trieNode.firstDirSize = static_cast<uint32_t>(firstDirSize);
+                trieNode.childBegin = 0;
+                trieNode.staticCount = 0;
+                trieNode.tagCount = 0;
+                trieNode.matcher = routeNode.matcher.get();
+                trieNode.routeCallback = nullptr;
+                if (routeNode.matcher)
                 {
-                    currentNode = it->second;
-                    continue;
+                    trie->matchers.push_back(routeNode.matcher);
                 }
-
-                // Find tag node using regex.
-                bool foundTagDir = false;
-                for (it = currentNode->tagTree.begin(); it != currentNode->tagTree.end(); it++)
+                if (routeNode.routeCallback)
                 {
-                    std::regex findRegex(it->second->dir);
-                    std::smatch match;
+                    // Copy callbacks, as the registered ones may be reassigned while the trie is in use.
+                    std::unique_ptr<RouteCallback> routeCallback(new RouteCallback());
+                    routeCallback->callback = routeNode.routeCallback->callback;
+                    routeCallback->captureCallback = routeNode.routeCallback->captureCallback;
+                    routeCallback->dataCallback = routeNode.routeCallback->dataCallback;
+                    trieNode.routeCallback = routeCallback.get();
+                    trie->callbacks.push_back(std::move(routeCallback));
+                }
+                trie->nodes.push_back(trieNode);
+                trie->prefixes += prefix;
+            };
 
-                    if (std::regex_search(dir, match, findRegex))
-                    {
-                        foundTagDir = true;
+            // Breadth first, keeping children of each node next to each other.
+            std::queue<const RouteNode *> queue;
+            addNode(*m_rootNode, "", 0);
+            queue.push(m_rootNode.get());
 
-                        for (size_t i = 1; i < match.size(); i++)
-                        {
-                            matches.push_back(match[i]);
-                        }
+            for (size_t index = 0; !queue.empty(); index++)
+            {
+                const RouteNode * routeNode = queue.front();
+                queue.pop();
 
-                        currentNode = it->second;
-                        break;
+                trie->nodes[index].childBegin = static_cast<uint32_t>(trie->nodes.size());
+                trie->nodes[index].staticCount = static_cast<uint32_t>(routeNode->regularTree.size());
+                trie->nodes[index].tagCount = static_cast<uint32_t>(routeNode->tagTree.size());
+
+                // Merge chains of static directories without routes or tags.
+                for (auto & pair : routeNode->regularTree)
+                {
+                    std::string prefix = pair.first;
+                    const RouteNode * child = pair.second.get();
+                    while (!child->routeCallback && child->tagTree.empty() && child->regularTree.size() == 1)
+                    {
+                        prefix += '/';
+                        prefix += child->regularTree.begin()->first;
+                        child = child->regularTree.begin()->second.get();
                     }
+
+                    addNode(*child, prefix, pair.first.size());
+                    queue.push(child);
                 }
 
-                if (foundTagDir)
+                // Try typed tags first, from the most specific one, and path tags last.
+                std::vector<const RouteNode *> tagNodes;
+                for (auto & pair : routeNode->tagTree)
                 {
-                    continue;
+                    tagNodes.push_back(pair.second.get());
                 }
+                std::stable_sort(tagNodes.begin(), tagNodes.end(), [](const RouteNode * a, const RouteNode * b)
+                {
+                    return getTypeRank(a->matcher->scanner) < getTypeRank(b->matcher->scanner);
+                });
 
-                // Failed to find any route.
-                return s_defaultCallbackFunc;
+                for (auto tagNode : tagNodes)
+                {
+                    addNode(*tagNode, "", 0);
+                    queue.push(tagNode);
+                }
             }
 
-            if (currentNode->routeCallback)
-            {
-                return currentNode->routeCallback->callback;
-            }
-            return s_defaultCallbackFunc;
+            std::shared_ptr<const RouteTrie> compiled(trie);
+            std::atomic_store_explicit(&m_trie, compiled, std::memory_order_release);
+            m_compiled.store(true, std::memory_order_release);
+            return compiled;
         }
 
-        // Route node.
-        RouteMethod::RouteNode::RouteNode() :
-            routeCallback(nullptr)
+        // Route path class.
+        RouteCallback::RouteCallback() :
+            m_compiled(nullptr)
         { }
 
-        RouteMethod::RouteNode::~RouteNode()
+        RouteCallback & RouteCallback::operator=(const Router::CallbackFunc & p_callback)
         {
-            for (auto it = regularTree.begin(); it != regularTree.end(); it++)
-            {
-                delete it->second;
-            }
+            callback = p_callback;
+            captureCallback = nullptr;
+            changed();
+            return *this;
+        }
+
+        RouteCallback & RouteCallback::operator=(const Router::CaptureCallbackFunc & p_callback)
+        {
+            callback = nullptr;
+            captureCallback = p_callback;
+            changed();
+            return *this;
+        }
 
-            for (auto it = tagTree.begin(); it != tagTree.end(); it++)
+        RouteCallback & RouteCallback::stream(const Router::DataFunc & onData, const Router::CallbackFunc & onEnd)
+        {
+            dataCallback = onData;
+            *this = onEnd;
+            return *this;
+        }
+
+        RouteCallback & RouteCallback::stream(const Router::DataFunc & onData, const Router::CaptureCallbackFunc & onEnd)
+        {
+            dataCallback = onData;
+            *this = onEnd;
+            return *this;
+        }
+
+        void RouteCallback::changed()
+        {
+            if (m_compiled)
             {
-                delete it->second;
+                *m_compiled = false;
             }
+        }
+
+        bool RouteCallback::routed() const
+        {
+            return callback != nullptr || captureCallback != nullptr;
+        }
+
+
+        // Route captures class.
+        const size_t RouteCaptures::capacity;
+        const size_t RouteCaptures::npos;
+
+        RouteCaptures::RouteCaptures() :
+            m_size(0),
+            m_path(nullptr)
+        { }
+
+        size_t RouteCaptures::size() const
+        {
+            return m_size;
+        }
+
+        bool RouteCaptures::empty() const
+        {
+            return m_size == 0;
+        }
+
+        StringView RouteCaptures::operator[](const size_t index) const
+        {
+            return StringView(m_path + m_entries[index].offset, m_entries[index].size);
+        }
+
+        StringView RouteCaptures::name(const size_t index) const
+        {
+            return m_entries[index].name;
+        }
+
+        RouteParameter::Type RouteCaptures::type(const size_t index) const
+        {
+            return m_entries[index].type;
+        }
+
+        int64_t RouteCaptures::integer(const size_t index) const
+        {
+            return m_entries[index].integer;
+        }
 
-            if (routeCallback != nullptr)
+        size_t RouteCaptures::find(const StringView & name) const
+        {
+            for (size_t i = 0; i < m_size; i++)
             {
-                delete routeCallback;
+                if (m_entries[i].name == name)
+                {
+                    return i;
+                }
             }
+            return npos;
         }
 
+        StringView RouteCaptures::value(const StringView & name) const
+        {
+            const size_t index = find(name);
+            return index != npos ? (*this)[index] : StringView();
+        }
 
-        // Route path class.
-        RouteCallback::RouteCallback()
-        { }
+        int64_t RouteCaptures::integer(const StringView & name, const int64_t defaultValue) const
+        {
+            const size_t index = find(name);
+            return index != npos ? m_entries[index].integer : defaultValue;
+        }
 
-        RouteCallback & RouteCallback::operator=(const Router::CallbackFunc & p_callback)
+        void RouteCaptures::reset(const char * path)
         {
-            callback = p_callback;
-            return *this;
+            m_size = 0;
+            m_path = path;
+        }
+
+        bool RouteCaptures::add(const StringView & name, const RouteParameter::Type type, const char * begin, const char * end, const int64_t integer)
+        {
+            if (m_size == capacity)
+            {
+                return false;
+            }
+
+            Entry & entry = m_entries[m_size++];
+            entry.name = name;
+            entry.offset = static_cast<size_t>(begin - m_path);
+            entry.size = static_cast<size_t>(end - begin);
+            entry.integer = integer;
+            entry.type = type;
+            return true;
+        }
+
+        void RouteCaptures::rebase(const char * path)
+        {
+            m_path = path;
         }
 
     }
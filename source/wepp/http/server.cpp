@@ -25,8 +25,12 @@
 
 #include "wepp/http/server.hpp"
 #include "wepp/priv/httpReceiver.hpp"
+#include "wepp/priv/outputBuffer.hpp"
+#include "wepp/priv/dateClock.hpp"
+#include "wepp/priv/byteScan.hpp"
 #include <chrono>
 #include <iostream>
+#include <algorithm>
 
 namespace Wepp
 {
@@ -34,7 +38,136 @@ namespace Wepp
     namespace Http
     {
 
-        Server::Server() :
+        static const size_t s_connectionBufferSize = 16384;
+        static const std::chrono::seconds s_pollTimeout(1);
+        static const size_t s_maxPipelinedOutput = 65536;
+        static const size_t s_gatherBodySize = 16384;
+
+        // Date of responses, shared by all servers.
+        static Priv::DateClock s_dateClock;
+
+        // Returns true if name is a valid field name, without control bytes, spaces or colons.
+        static bool isValidFieldName(const StringView & name)
+        {
+            const char * end = name.data() + name.size();
+            return !name.empty() &&
+                   Priv::findControl(name.data(), end, 0x20) == end &&
+                   Priv::findByte(name.data(), end, ':') == end;
+        }
+
+        // Appends field value, stripping control bytes except tab, so handlers can not inject header fields.
+        static void appendFieldValue(Priv::OutputBuffer & output, const StringView & value)
+        {
+            const char * position = value.data();
+            const char * end = value.data() + value.size();
+            while (position < end)
+            {
+                const char * control = Priv::findControl(position, end, 0x1F);
+                output.append(position, static_cast<size_t>(control - position));
+                if (control == end)
+                {
+                    break;
+                }
+                if (*control == '\t')
+                {
+                    output.append("\t", 1);
+                }
+                position = control + 1;
+            }
+        }
+
+        // Serializes status line and header fields of response into output, without allocating once output has grown to fit it.
+        static void writeResponseHeader(Priv::OutputBuffer & output, const Response & response, const size_t contentLength, const bool keepAlive)
+        {
+            static const StringView s_versionPrefix("HTTP/1.1 ");
+            static const StringView s_server("Server: Wepp\r\n");
+            static const StringView s_date("Date: ");
+            static const StringView s_contentLength("Content-Length: ");
+            static const StringView s_keepAlive("\r\nConnection: keep-alive\r\n\r\n");
+            static const StringView s_close("\r\nConnection: close\r\n\r\n");
+
+            const StringView statusLine = getStatusLine(response.status());
+            if (statusLine.size())
+            {
+                output.append(statusLine);
+            }
+            else
+            {
+                output.append(s_versionPrefix);
+                output.appendInteger(static_cast<uint64_t>(response.status()));
+                output.append(" \r\n", 3);
+            }
+
+            for (auto & field : response.headers())
+            {
+                // Fields of invalid names are dropped, control bytes are stripped from values.
+                if (field.id != HeaderId::ContentLength && field.id != HeaderId::Connection && isValidFieldName(field.first))
+                {
+                    output.append(field.first);
+                    output.append(": ", 2);
+                    appendFieldValue(output, field.second);
+                    output.append("\r\n", 2);
+                }
+            }
+            if (response.headers().find(HeaderId::Date) == response.headers().end())
+            {
+                output.append(s_date);
+                s_dateClock.copy(output.extend(Priv::DateClock::dateSize));
+                output.append("\r\n", 2);
+            }
+            if (response.headers().find(HeaderId::Server) == response.headers().end())
+            {
+                output.append(s_server);
+            }
+
+            output.append(s_contentLength);
+            output.appendInteger(contentLength);
+            output.append(keepAlive ? s_keepAlive : s_close);
+        }
+
+        // Returns true if the connection header of request contains the "close" option.
+        static bool requestsClose(const Request & request)
+        {
+            const StringView value = request.header(HeaderId::Connection);
+
+            size_t position = 0;
+            while (position < value.size())
+            {
+                size_t end = value.find(',', position);
+                end = end == StringView::npos ? value.size() : end;
+
+                StringView option = value.substr(position, end - position);
+                while (!option.empty() && (option[0] == ' ' || option[0] == '\t'))
+                {
+                    option = option.substr(1);
+                }
+                while (!option.empty() && (option[option.size() - 1] == ' ' || option[option.size() - 1] == '\t'))
+                {
+                    option = option.substr(0, option.size() - 1);
+                }
+
+                if (option.equalsIgnoreCase("close"))
+                {
+                    return true;
+                }
+                position = end + 1;
+            }
+
+            return false;
+        }
+
+        Server::Settings::Settings() :
+            keepAliveMaxRequests(1000),
+            keepAliveTimeout(std::chrono::seconds(5)),
+            bodyMemoryLimit(1024 * 1024),
+            bodySizeLimit(64 * 1024 * 1024)
+        { }
+
+        Server::Server(const Settings & settings) :
+            m_settings(settings),
+            m_staticRouter(nullptr),
+            m_staticFindRoute(nullptr),
+            m_staticCallRoute(nullptr),
             m_running(false),
             m_stopped(true)
         { }
@@ -63,68 +196,33 @@ namespace Wepp
                 return task.fail();
             }
             m_stopped = false;
+            route.publish();
 
             m_stopTask = TaskController<>();
 
+            if (m_thread.joinable())
+            {
+                m_thread.join();
+            }
+
             // Start main thread.
             m_thread = std::thread([this, task, port, endpoint]() mutable
             {
                 const size_t poolMin = 10;
                 const size_t poolMax = 100;
 
-                m_receivePool.start(poolMin, poolMax, [this](Priv::HttpReceiver & receiver, std::shared_ptr<Socket::TcpSocket> socket)
+                m_receivePool.start(poolMin, poolMax, [this](std::shared_ptr<Priv::HttpConnection> connection)
                 {
-                    Router::CallbackFunc callbackFunction = nullptr;
-                    Request request;
-                    Response response;
-
-                    const auto status = receiver.receive(socket, request, response,
-
-                        // On request.
-                        [this, &callbackFunction](Request & request, Response & response) mutable -> bool
-                        {
-                            std::vector<std::string> matches;
-                            callbackFunction = route.find(request.method(), request.resource(), matches);
-                            if (callbackFunction == nullptr)
-                            {
-                                response.status(Status::NotFound);
-                                return false;
-                            }
-                            return true;
-                        }
-                    );
-
-                    // Execute callback.
-                    if (status == Priv::HttpReceiver::Status::Ok && callbackFunction)
+                    if (!handleConnection(connection))
                     {
-                        callbackFunction(request, response);
+                        closeConnection(*connection);
                     }
-
-                    if (status != Priv::HttpReceiver::Status::Disconnected)
-                    {
-                        // Send response
-                        auto & body = response.body();
-
-                        std::string responseStart =
-                            "HTTP/1.1 ";
-                        responseStart += std::to_string(static_cast<unsigned long long>(response.status()));
-                        responseStart += " " + getStatusAsString(response.status());
-                        responseStart += "\r\n";
-                        responseStart +=
-                            "Server: Wepp\r\n"
-                            "Content-Length: " + std::to_string(body.size()) + "\r\n"
-                            "Connection: Closed\r\n\r\n";
-                         
-                        socket->send(responseStart);
-                        socket->send(body.data(), body.size());
-                    }
-
                 }).wait();
 
-
-                // Start listener.
-                if (!m_listener.start(port, endpoint).wait().successful())
+                // Start acceptor.
+                if (!m_acceptor.open(port, endpoint) || !m_poller.add(m_acceptor.handle(), &m_acceptor, false))
                 {
+                    m_acceptor.close();
                     m_stopped = true;
                     task.fail();
                     return;
@@ -135,23 +233,43 @@ namespace Wepp
                 m_stopped = false;
                 task.finish();
 
-                // Listen loop.
+                // Poll loop.
+                const std::chrono::duration<double> sweepInterval = std::min<std::chrono::duration<double>>(s_pollTimeout, m_settings.keepAliveTimeout);
+                auto lastSweep = std::chrono::steady_clock::now();
+
+                std::vector<Priv::Poller::Event> events;
+                bool acceptPending = false;
                 while (m_running)
                 {
-                    auto connection = m_listener.listen().wait();
+                    m_poller.wait(events, sweepInterval);
 
-                    if (!m_running)
+                    // The edge-triggered acceptor is not notified again for connections left pending by a failure.
+                    if (acceptPending)
                     {
-                        break;
+                        acceptPending = !acceptConnections();
                     }
 
-                    if (connection.successful())
+                    for (auto & event : events)
                     {
-                       m_receivePool.enqueue(connection());
+                        if (!m_running)
+                        {
+                            break;
+                        }
+
+                        if (event.data == &m_acceptor)
+                        {
+                            acceptPending = !acceptConnections();
+                            continue;
+                        }
+
+                        receiveConnection(static_cast<Priv::HttpConnection *>(event.data));
                     }
-                    else
+
+                    const auto now = std::chrono::steady_clock::now();
+                    if (now - lastSweep >= sweepInterval)
                     {
-                        std::cerr << "Failed listen task.";
+                        closeIdleConnections();
+                        lastSweep = now;
                     }
                 }
 
@@ -170,23 +288,329 @@ namespace Wepp
                 return m_stopTask.finish();
             }
 
-            m_listener.stop();
-
             m_running = false;
+            m_poller.interrupt();
             return m_stopTask;
         }
 
+        void Server::routeFinder(const FindRouteFunc & findRoute)
+        {
+            m_findRoute = findRoute;
+            m_staticRouter = nullptr;
+        }
+
         void Server::handleStop()
         {
             std::lock_guard<std::mutex> lock(m_stopQueueMutex);
 
             //m_recivePool.stop().wait();
-            m_listener.stop().wait();
+            m_poller.remove(m_acceptor.handle());
+            m_acceptor.close();
+            {
+                std::lock_guard<std::mutex> connectionsLock(m_connectionsMutex);
+                for (auto & connection : m_connections)
+                {
+                    closeConnection(*connection.second);
+                }
+                m_connections.clear();
+            }
 
             m_stopped = true;
             m_stopTask.finish();
         }
 
+        bool Server::acceptConnections()
+        {
+            // Edge-triggered, accept until no connection is pending.
+            Socket::TcpAcceptor::AcceptStatus status;
+            while (true)
+            {
+                auto socket = m_acceptor.accept(status);
+                if (status == Socket::TcpAcceptor::AcceptStatus::WouldBlock)
+                {
+                    return true;
+                }
+                if (status == Socket::TcpAcceptor::AcceptStatus::OutOfDescriptors)
+                {
+                    continue;
+                }
+                if (status == Socket::TcpAcceptor::AcceptStatus::Error)
+                {
+                    std::cerr << "Failed to accept connection.";
+                    return false;
+                }
+
+                auto connection = std::make_shared<Priv::HttpConnection>(socket, s_connectionBufferSize);
+
+                std::lock_guard<std::mutex> lock(m_connectionsMutex);
+                m_connections.insert({ connection.get(), connection });
+                if (!m_poller.add(socket->handle(), connection.get(), true))
+                {
+                    std::cerr << "Failed to add connection to poller.";
+                    m_connections.erase(connection.get());
+                }
+            }
+        }
+
+        void Server::receiveConnection(Priv::HttpConnection * connection)
+        {
+            std::shared_ptr<Priv::HttpConnection> sharedConnection;
+            {
+                std::lock_guard<std::mutex> lock(m_connectionsMutex);
+
+                auto it = m_connections.find(connection);
+                if (it == m_connections.end())
+                {
+                    return;
+                }
+                sharedConnection = it->second;
+            }
+
+            // Only this thread removes connections from the map, it's safe to receive without the lock.
+            const auto receiveStatus = connection->receiveAvailable();
+            const bool closed = receiveStatus == Priv::HttpConnection::ReceiveStatus::Disconnected ||
+                                receiveStatus == Priv::HttpConnection::ReceiveStatus::Error;
+
+            if (!closed)
+            {
+                connection->touch();
+
+                if (!connection->buffer().unreadBytes())
+                {
+                    m_poller.rearm(connection->socket().handle(), connection);
+                    return;
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_connectionsMutex);
+                m_connections.erase(connection);
+            }
+
+            // Let a worker parse the received data, resuming any partially parsed request.
+            // Closed connections are destroyed when leaving this function.
+            if (closed)
+            {
+                closeConnection(*connection);
+                return;
+            }
+            m_receivePool.enqueue(sharedConnection);
+        }
+
+        bool Server::parkConnection(std::shared_ptr<Priv::HttpConnection> connection)
+        {
+            std::lock_guard<std::mutex> lock(m_connectionsMutex);
+
+            if (!m_running)
+            {
+                return false;
+            }
+
+            connection->touch();
+            m_connections.insert({ connection.get(), connection });
+            if (!m_poller.rearm(connection->socket().handle(), connection.get()))
+            {
+                m_connections.erase(connection.get());
+                return false;
+            }
+            return true;
+        }
+
+        void Server::closeIdleConnections()
+        {
+            std::lock_guard<std::mutex> lock(m_connectionsMutex);
+
+            const auto now = std::chrono::steady_clock::now();
+            for (auto it = m_connections.begin(); it != m_connections.end();)
+            {
+                if (now - it->second->lastActivity() >= m_settings.keepAliveTimeout)
+                {
+                    closeConnection(*it->second);
+                    it = m_connections.erase(it);
+                    continue;
+                }
+                it++;
+            }
+        }
+
+        void Server::closeConnection(Priv::HttpConnection & connection)
+        {
+            // Closed handles may be reused by new connections, remove while the socket is still open.
+            m_poller.remove(connection.socket().handle());
+        }
+
+        bool Server::handleConnection(std::shared_ptr<Priv::HttpConnection> connection)
+        {
+            static const StringView s_continue("HTTP/1.1 100 Continue\r\n\r\n");
+
+            auto & buffer = connection->buffer();
+            auto & receiver = connection->receiver();
+            auto & request = connection->request();
+            auto & response = connection->response();
+
+            // Responses are serialized into an output arena of the worker, reused by every connection it handles.
+            // Output is always sent before returning, except when the connection failed.
+            static thread_local Priv::OutputBuffer t_output;
+            auto & output = t_output;
+            output.clear();
+
+            // On request.
+            auto onRequest = [this, &connection](Request & request, Response & response) -> bool
+            {
+                const RouteCallback * routeCallback = nullptr;
+                if (m_staticRouter)
+                {
+                    routeCallback = m_staticFindRoute(m_staticRouter, request.methodView(), request.resourceView(), connection->routeCaptures());
+                }
+                else if (m_findRoute)
+                {
+                    routeCallback = m_findRoute(request.method(), request.resourceView(), connection->routeCaptures());
+                }
+                else
+                {
+                    // The connection owns the routes of the request until it is handled, even if the routes are republished.
+                    auto snapshot = route.snapshot();
+                    routeCallback = snapshot->findRoute(request.methodView(), request.resourceView(), connection->routeCaptures());
+                    connection->routeSnapshot(std::move(snapshot));
+                }
+                connection->routeCallback(routeCallback);
+                if (routeCallback == nullptr || !routeCallback->routed())
+                {
+                    response.status(Status::NotFound);
+                    return false;
+                }
+                return true;
+            };
+
+            // On body data, streamed to the route or buffered in request.
+            auto onData = [&connection](Request & request, Response & response, const StringView & data) -> bool
+            {
+                if (connection->routeCallback()->dataCallback)
+                {
+                    return connection->routeCallback()->dataCallback(request, response, data);
+                }
+                // The body could not be stored, the connection is closed.
+                if (request.body().append(data.data(), data.size()).failed())
+                {
+                    response.status(Status::InsufficientStorage);
+                    return false;
+                }
+                return true;
+            };
+
+            while (true)
+            {
+                request.body().spillThreshold(m_settings.bodyMemoryLimit);
+                receiver.limitBodySize(m_settings.bodySizeLimit);
+
+                const auto status = receiver.parse(buffer, request, response, onRequest, onData);
+
+                // Wait for more data in the poller. Responses are sent first, the next worker may write to the socket.
+                if (status == Priv::HttpReceiver::Status::NeedMore)
+                {
+                    if (!output.empty() && !connection->send(output.data(), output.size(), m_settings.keepAliveTimeout))
+                    {
+                        return false;
+                    }
+                    output.clear();
+                    output.shrink(s_maxPipelinedOutput);
+                    return parkConnection(connection);
+                }
+
+                // Responses of earlier requests must be sent before the interim response.
+                if (status == Priv::HttpReceiver::Status::ExpectContinue)
+                {
+                    output.append(s_continue);
+                    if (!connection->send(output.data(), output.size(), m_settings.keepAliveTimeout))
+                    {
+                        return false;
+                    }
+                    output.clear();
+                    continue;
+                }
+
+                // Execute callback.
+                const RouteCallback * routeCallback = connection->routeCallback();
+                bool failed = false;
+                if (status == Priv::HttpReceiver::Status::Ok && routeCallback && request.body().spilled() && !request.body().data())
+                {
+                    // The spilled body could not be mapped.
+                    response.status(Status::InternalServerError);
+                    failed = true;
+                }
+                else if (status == Priv::HttpReceiver::Status::Ok && routeCallback)
+                {
+                    if (m_staticRouter)
+                    {
+                        auto & captures = connection->routeCaptures();
+                        captures.rebase(request.resourceView().data());
+                        m_staticCallRoute(m_staticRouter, routeCallback, request, response, captures);
+                    }
+                    else if (routeCallback->captureCallback)
+                    {
+                        // The resource may have been copied from the receive buffer while receiving the body.
+                        auto & captures = connection->routeCaptures();
+                        captures.rebase(request.resourceView().data());
+                        routeCallback->captureCallback(request, response, captures);
+                    }
+                    else
+                    {
+                        routeCallback->callback(request, response);
+                    }
+                }
+
+                // A spilled response body that could not be mapped is replaced by an error.
+                auto & body = response.body();
+                if (body.size() && !body.data())
+                {
+                    response.status(Status::InternalServerError);
+                    body.clear();
+                    failed = true;
+                }
+
+                // Keep the connection alive unless the request failed, the client asked to close or the limit is reached.
+                connection->countRequest();
+                const bool keepAlive = status == Priv::HttpReceiver::Status::Ok && !failed &&
+                                       connection->requestCount() < m_settings.keepAliveMaxRequests &&
+                                       !requestsClose(request);
+
+                // Queue response. Responses of pipelined requests are flushed together.
+
+                writeResponseHeader(output, response, body.size(), keepAlive);
+                if (body.size() < s_gatherBodySize)
+                {
+                    output.append(body.data(), body.size());
+                }
+                else
+                {
+                    // Large bodies are not copied, but sent together with the buffered output in a single gather write.
+                    const Socket::SendBuffer buffers[] = { { output.data(), output.size() }, { body.data(), body.size() } };
+                    if (!connection->send(buffers, 2, m_settings.keepAliveTimeout))
+                    {
+                        return false;
+                    }
+                    output.clear();
+                }
+
+                connection->resetRequest();
+
+                if (!keepAlive || output.size() >= s_maxPipelinedOutput)
+                {
+                    if (!connection->send(output.data(), output.size(), m_settings.keepAliveTimeout))
+                    {
+                        return false;
+                    }
+                    output.clear();
+                    output.shrink(s_maxPipelinedOutput);
+                }
+
+                if (!keepAlive)
+                {
+                    return false;
+                }
+            }
+        }
+
     }
 
 }
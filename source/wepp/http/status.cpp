@@ -25,6 +25,71 @@
 
 #include "wepp/http/status.hpp"
 
+// List of status enumerators, codes and reason phrases. Reason strings and status lines are generated from it.
+#define WEPP_HTTP_STATUS_LIST(X) \
+    X(Continue,                      100, "Continue") \
+    X(SwitchingProtocols,            101, "Switching Protocols") \
+    X(Processing,                    102, "Processing") \
+    X(EarlyHints,                    103, "Early Hints") \
+    X(Ok,                            200, "OK") \
+    X(Created,                       201, "Created") \
+    X(Accepted,                      202, "Accepted") \
+    X(NonAuthoritativeInformation,   203, "Non-Authoritative Information") \
+    X(NoContent,                     204, "No Content") \
+    X(ResetContent,                  205, "Reset Content") \
+    X(PartialContent,                206, "Partial Content") \
+    X(MultiStatus,                   207, "Multi-Status") \
+    X(AlreadyReported,               208, "Already Reported") \
+    X(ImUsed,                        226, "I'm Used") \
+    X(MultipleChoices,               300, "Multiple Choices") \
+    X(MovedPermanently,              301, "Moved Permanently") \
+    X(Found,                         302, "Found") \
+    X(SeeOther,                      303, "See Other") \
+    X(NotModified,                   304, "Not Modified") \
+    X(UseProxy,                      305, "Use Proxy") \
+    X(SwitchProxy,                   306, "Switch Proxy") \
+    X(TemporaryRedirect,             307, "Temporary Redirect") \
+    X(PermanentRedirect,             308, "Permanent Redirect") \
+    X(BadRequest,                    400, "Bad Request") \
+    X(Unauthorized,                  401, "Unauthorized") \
+    X(PaymentRequired,               402, "Payment Required") \
+    X(Forbidden,                     403, "Forbidden") \
+    X(NotFound,                      404, "Not Found") \
+    X(MethodNotAllowed,              405, "Method Not Allowed") \
+    X(NotAcceptable,                 406, "Not Acceptable") \
+    X(ProxyAuthenticationRequired,   407, "Proxy Authentication Required") \
+    X(RequestTimeout,                408, "Request Timeout") \
+    X(Conflict,                      409, "Conflict") \
+    X(Gone,                          410, "Gone") \
+    X(LengthRequired,                411, "Length Required") \
+    X(PreconditionFailed,            412, "Precondition Failed") \
+    X(PayloadTooLarge,               413, "Payload Too Large") \
+    X(UriTooLong,                    414, "Uri Too Long") \
+    X(UnsupportedMediaType,          415, "Unsupported Media Type") \
+    X(RangeNotSatisfiable,           416, "Range Not Satisfiable") \
+    X(ExpectationFailed,             417, "Expectation Failed") \
+    X(ImATeapot,                     418, "I'm A Teapot") \
+    X(MisdirectedRequest,            421, "Misdirected Request") \
+    X(UnprocessableEntity,           422, "Unprocessable Entity") \
+    X(Locked,                        423, "Locked") \
+    X(FailedDependency,              424, "Failed Dependency") \
+    X(UpgradeRequired,               426, "Upgrade Required") \
+    X(PreconditionRequired,          428, "Precondition Required") \
+    X(TooManyRequests,               429, "Too Many Requests") \
+    X(RequestHeaderFieldsTooLarge,   431, "Request Header Fields Too Large") \
+    X(UnavailableForLegalReasons,    451, "Unavailable For Legal Reasons") \
+    X(InternalServerError,           500, "Internal Server Error") \
+    X(NotImplemented,                501, "Not Implemented") \
+    X(BadGateway,                    502, "Bad Gateway") \
+    X(ServiceUnavailable,            503, "Service Unavailable") \
+    X(GatewayTimeout,                504, "Gateway Timeout") \
+    X(HttpVersionNotSupported,       505, "Http Version Not Supported") \
+    X(VariantAlsoNegotiates,         506, "Variant Also Negotiates") \
+    X(InsufficientStorage,           507, "Insufficient Storage") \
+    X(LoopDetected,                  508, "Loop Detected") \
+    X(NotExtended,                   510, "Not Extended") \
+    X(NetworkAuthenticationRequired, 511, "Network Authentication Required")
+
 namespace Wepp
 {
 
@@ -33,151 +98,41 @@ namespace Wepp
 
         static const std::string s_EmptyString = "";
 
-        static const std::string s_Continue = "Continue";
-        static const std::string s_SwitchingProtocols = "Switching Protocols";
-        static const std::string s_Processing = "Processing";
-        static const std::string s_EarlyHints = "Early Hints";
-
-        static const std::string s_Ok = "OK";
-        static const std::string s_Created = "Created";
-        static const std::string s_Accepted = "Accepted";
-        static const std::string s_NonAuthoritativeInformation = "Non-Authoritative Information";
-        static const std::string s_NoContent= "No Content";
-        static const std::string s_ResetContent = "Reset Content";
-        static const std::string s_PartialContent = "Partial Content";
-        static const std::string s_MultiStatus = "Multi-Status";
-        static const std::string s_AlreadyReported = "Already Reported";
-        static const std::string s_ImUsed = "I'm Used";
-        
-        static const std::string s_MultipleChoices = "Multiple Choices";
-        static const std::string s_MovedPermanently = "Moved Permanently";
-        static const std::string s_Found = "Found";
-        static const std::string s_SeeOther = "See Other";
-        static const std::string s_NotModified = "Not Modified";
-        static const std::string s_UseProxy = "Use Proxy";
-        static const std::string s_SwitchProxy = "Switch Proxy";
-        static const std::string s_TemporaryRedirect = "Temporary Redirect";
-        static const std::string s_PermanentRedirect = "Permanent Redirect";
+        #define WEPP_HTTP_STATUS_STRING(name, code, reason) static const std::string s_##name = reason;
+        WEPP_HTTP_STATUS_LIST(WEPP_HTTP_STATUS_STRING)
+        #undef WEPP_HTTP_STATUS_STRING
 
-        static const std::string s_BadRequest = "Bad Request";
-        static const std::string s_Unauthorized = "Unauthorized";
-        static const std::string s_PaymentRequired = "Payment Required";
-        static const std::string s_Forbidden = "Forbidden";
-        static const std::string s_NotFound = "Not Found";
-        static const std::string s_MethodNotAllowed = "Method Not Allowed";
-        static const std::string s_NotAcceptable = "Not Acceptable";
-        static const std::string s_ProxyAuthenticationRequired = "Proxy Authentication Required";
-        static const std::string s_RequestTimeout = "Request Timeout";
-        static const std::string s_Conflict = "Conflict";
-        static const std::string s_Gone = "Gone";
-        static const std::string s_LengthRequired = "Length Required";
-        static const std::string s_PreconditionFailed = "Precondition Failed";
-        static const std::string s_PayloadTooLarge = "Payload Too Large";
-        static const std::string s_UriTooLong = "Uri Too Long";
-        static const std::string s_UnsupportedMediaType = "Unsupported Media Type";
-        static const std::string s_RangeNotSatisfiable = "Range Not Satisfiable";
-        static const std::string s_ExpectationFailed = "Expectation Failed";
-        static const std::string s_ImATeapot = "I'm A Teapot";
-        static const std::string s_MisdirectedRequest = "Misdirected Request";
-        static const std::string s_UnprocessableEntity = "Unprocessable Entity";
-        static const std::string s_Locked = "Locked";
-        static const std::string s_FailedDependency = "Failed Dependency";
-        static const std::string s_UpgradeRequired = "Upgrade Required";
-        static const std::string s_PreconditionRequired = "Precondition Required";
-        static const std::string s_TooManyRequests = "Too Many Requests";
-        static const std::string s_RequestHeaderFieldsTooLarge = "Request Header Fields Too Large";
-        static const std::string s_UnavailableForLegalReasons = "Unavailable For Legal Reasons";
-            
-        static const std::string s_InternalServerError = "Internal Server Error";
-        static const std::string s_NotImplemented = "Not Implemented";
-        static const std::string s_BadGateway = "Bad Gateway";
-        static const std::string s_ServiceUnavailable = "Service Unavailable";
-        static const std::string s_GatewayTimeout = "Gateway Timeout";
-        static const std::string s_HttpVersionNotSupported = "Http Version Not Supported";
-        static const std::string s_VariantAlsoNegotiates = "Variant Also Negotiates";
-        static const std::string s_InsufficientStorage = "Insufficient Storage";
-        static const std::string s_LoopDetected = "Loop Detected";
-        static const std::string s_NotExtended = "Not Extended";
-        static const std::string s_NetworkAuthenticationRequired = "Network Authentication Required";
+        // Status lines are concatenated at compile time, ready to be copied into responses.
+        #define WEPP_HTTP_STATUS_LINE(name, code, reason) static const char s_##name##Line[] = "HTTP/1.1 " #code " " reason "\r\n";
+        WEPP_HTTP_STATUS_LIST(WEPP_HTTP_STATUS_LINE)
+        #undef WEPP_HTTP_STATUS_LINE
 
-            
         const std::string & getStatusAsString(const Status status)
         {
-
             switch (status)
             {
-                case Status::Continue:                      return s_Continue; break;
-                case Status::SwitchingProtocols:            return s_SwitchingProtocols; break;
-                case Status::Processing:                    return s_Processing; break;
-                case Status::EarlyHints:                    return s_EarlyHints; break;
-
-                case Status::Ok:                            return s_Ok; break;
-                case Status::Created:                       return s_Created; break;
-                case Status::Accepted:                      return s_Accepted; break;
-                case Status::NonAuthoritativeInformation:   return s_NonAuthoritativeInformation; break;
-                case Status::NoContent:                     return s_NoContent; break;
-                case Status::ResetContent:                  return s_ResetContent; break;
-                case Status::PartialContent:                return s_PartialContent; break;
-                case Status::MultiStatus:                   return s_MultiStatus; break;
-                case Status::AlreadyReported:               return s_AlreadyReported; break;
-                case Status::ImUsed:                        return s_ImUsed; break;
- 
-                case Status::MultipleChoices:               return s_MultipleChoices; break;
-                case Status::MovedPermanently:              return s_MovedPermanently; break;
-                case Status::Found:                         return s_Found; break;
-                case Status::SeeOther:                      return s_SeeOther; break;
-                case Status::NotModified:                   return s_NotModified; break;
-                case Status::UseProxy:                      return s_UseProxy; break;
-                case Status::SwitchProxy:                   return s_SwitchProxy; break;
-                case Status::TemporaryRedirect:             return s_TemporaryRedirect; break;
-                case Status::PermanentRedirect:             return s_PermanentRedirect; break;
+                #define WEPP_HTTP_STATUS_CASE(name, code, reason) case Status::name: return s_##name;
+                WEPP_HTTP_STATUS_LIST(WEPP_HTTP_STATUS_CASE)
+                #undef WEPP_HTTP_STATUS_CASE
+                default: break;
+            }
 
-                case Status::BadRequest:                    return s_BadRequest; break;
-                case Status::Unauthorized:                  return s_Unauthorized; break;
-                case Status::PaymentRequired:               return s_PaymentRequired; break;
-                case Status::Forbidden:                     return s_Forbidden; break;
-                case Status::NotFound:                      return s_NotFound; break;
-                case Status::MethodNotAllowed:              return s_MethodNotAllowed; break;
-                case Status::NotAcceptable:                 return s_NotAcceptable; break;
-                case Status::ProxyAuthenticationRequired:   return s_ProxyAuthenticationRequired; break;
-                case Status::RequestTimeout:                return s_RequestTimeout; break;
-                case Status::Conflict:                      return s_Conflict; break;
-                case Status::Gone:                          return s_Gone; break;
-                case Status::LengthRequired:                return s_LengthRequired; break;
-                case Status::PreconditionFailed:            return s_PreconditionFailed; break;
-                case Status::PayloadTooLarge:               return s_PayloadTooLarge; break;
-                case Status::UriTooLong:                    return s_UriTooLong; break;
-                case Status::UnsupportedMediaType:          return s_UnsupportedMediaType; break;
-                case Status::RangeNotSatisfiable:           return s_RangeNotSatisfiable; break;
-                case Status::ExpectationFailed:             return s_ExpectationFailed; break;
-                case Status::ImATeapot:                     return s_ImATeapot; break;
-                case Status::MisdirectedRequest:            return s_MisdirectedRequest; break;
-                case Status::UnprocessableEntity:           return s_UnprocessableEntity; break;
-                case Status::Locked:                        return s_Locked; break;
-                case Status::FailedDependency:              return s_FailedDependency; break;
-                case Status::UpgradeRequired:               return s_UpgradeRequired; break;
-                case Status::PreconditionRequired:          return s_PreconditionRequired; break;
-                case Status::TooManyRequests:               return s_TooManyRequests; break;
-                case Status::RequestHeaderFieldsTooLarge:   return s_RequestHeaderFieldsTooLarge; break;
-                case Status::UnavailableForLegalReasons:    return s_UnavailableForLegalReasons; break;
+            return s_EmptyString;
+        }
 
-                case Status::InternalServerError:           return s_InternalServerError; break;
-                case Status::NotImplemented:                return s_NotImplemented; break;
-                case Status::BadGateway:                    return s_BadGateway; break;
-                case Status::ServiceUnavailable:            return s_ServiceUnavailable; break;
-                case Status::GatewayTimeout:                return s_GatewayTimeout; break;
-                case Status::HttpVersionNotSupported:       return s_HttpVersionNotSupported; break;
-                case Status::VariantAlsoNegotiates:         return s_VariantAlsoNegotiates; break;
-                case Status::InsufficientStorage:           return s_InsufficientStorage; break;
-                case Status::LoopDetected:                  return s_LoopDetected; break;
-                case Status::NotExtended:                   return s_NotExtended; break;
-                case Status::NetworkAuthenticationRequired: return s_NetworkAuthenticationRequired; break;
-                default:    break;
+        StringView getStatusLine(const Status status)
+        {
+            switch (status)
+            {
+                #define WEPP_HTTP_STATUS_CASE(name, code, reason) case Status::name: return StringView(s_##name##Line, sizeof(s_##name##Line) - 1);
+                WEPP_HTTP_STATUS_LIST(WEPP_HTTP_STATUS_CASE)
+                #undef WEPP_HTTP_STATUS_CASE
+                default: break;
             }
 
-            return s_EmptyString;
+            return StringView();
         }
 
     }
 
-}
\ No newline at end of file
+}
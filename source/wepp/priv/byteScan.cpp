@@ -0,0 +1,208 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include "wepp/priv/byteScan.hpp"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define WEPP_BYTE_SCAN_SSE2
+    #include <emmintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#endif
+#if defined(WEPP_BYTE_SCAN_SSE2) && (defined(__GNUC__) || defined(__clang__))
+    #define WEPP_BYTE_SCAN_AVX2
+    #include <immintrin.h>
+#endif
+
+namespace Wepp
+{
+
+    namespace Priv
+    {
+
+        namespace
+        {
+
+            typedef const char * (*FindByteFunction)(const char *, const char *, const char);
+            typedef const char * (*FindControlFunction)(const char *, const char *, const unsigned char);
+
+            const char * findByteScalar(const char * begin, const char * end, const char byte)
+            {
+                return std::find(begin, end, byte);
+            }
+
+            const char * findControlScalar(const char * begin, const char * end, const unsigned char limit)
+            {
+                for (; begin != end; ++begin)
+                {
+                    const unsigned char c = static_cast<unsigned char>(*begin);
+                    if (c <= limit || c == 0x7F)
+                    {
+                        break;
+                    }
+                }
+                return begin;
+            }
+
+        #if defined(WEPP_BYTE_SCAN_SSE2)
+
+            inline unsigned int firstBit(const unsigned int mask)
+            {
+            #if defined(_MSC_VER)
+                unsigned long index = 0;
+                _BitScanForward(&index, mask);
+                return static_cast<unsigned int>(index);
+            #else
+                return static_cast<unsigned int>(__builtin_ctz(mask));
+            #endif
+            }
+
+            const char * findByteSse2(const char * begin, const char * end, const char byte)
+            {
+                const __m128i needle = _mm_set1_epi8(byte);
+                for (; end - begin >= 16; begin += 16)
+                {
+                    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+                    const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)));
+                    if (mask)
+                    {
+                        return begin + firstBit(mask);
+                    }
+                }
+                return findByteScalar(begin, end, byte);
+            }
+
+            const char * findControlSse2(const char * begin, const char * end, const unsigned char limit)
+            {
+                const __m128i limits = _mm_set1_epi8(static_cast<char>(limit));
+                const __m128i deletes = _mm_set1_epi8(0x7F);
+                for (; end - begin >= 16; begin += 16)
+                {
+                    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+                    // Unsigned chunk <= limit, if min(chunk, limit) == chunk.
+                    const __m128i controls = _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(chunk, limits), chunk),
+                                                          _mm_cmpeq_epi8(chunk, deletes));
+                    const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(controls));
+                    if (mask)
+                    {
+                        return begin + firstBit(mask);
+                    }
+                }
+                return findControlScalar(begin, end, limit);
+            }
+
+        #endif
+
+        #if defined(WEPP_BYTE_SCAN_AVX2)
+
+            __attribute__((target("avx2")))
+            const char * findByteAvx2(const char * begin, const char * end, const char byte)
+            {
+                const __m256i needle = _mm256_set1_epi8(byte);
+                for (; end - begin >= 32; begin += 32)
+                {
+                    const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+                    const unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)));
+                    if (mask)
+                    {
+                        return begin + firstBit(mask);
+                    }
+                }
+                return findByteSse2(begin, end, byte);
+            }
+
+            __attribute__((target("avx2")))
+            const char * findControlAvx2(const char * begin, const char * end, const unsigned char limit)
+            {
+                const __m256i limits = _mm256_set1_epi8(static_cast<char>(limit));
+                const __m256i deletes = _mm256_set1_epi8(0x7F);
+                for (; end - begin >= 32; begin += 32)
+                {
+                    const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+                    const __m256i controls = _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(chunk, limits), chunk),
+                                                             _mm256_cmpeq_epi8(chunk, deletes));
+                    const unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(controls));
+                    if (mask)
+                    {
+                        return begin + firstBit(mask);
+                    }
+                }
+                return findControlSse2(begin, end, limit);
+            }
+
+        #endif
+
+            struct Dispatch
+            {
+                Dispatch() :
+                    findByte(findByteScalar),
+                    findControl(findControlScalar),
+                    instructionSet("scalar")
+                {
+                #if defined(WEPP_BYTE_SCAN_SSE2)
+                    findByte = findByteSse2;
+                    findControl = findControlSse2;
+                    instructionSet = "sse2";
+                #endif
+                #if defined(WEPP_BYTE_SCAN_AVX2)
+                    __builtin_cpu_init();
+                    if (__builtin_cpu_supports("avx2"))
+                    {
+                        findByte = findByteAvx2;
+                        findControl = findControlAvx2;
+                        instructionSet = "avx2";
+                    }
+                #endif
+                }
+
+                FindByteFunction    findByte;
+                FindControlFunction findControl;
+                const char *        instructionSet;
+            };
+
+            static const Dispatch s_dispatch;
+
+        }
+
+        const char * findByte(const char * begin, const char * end, const char byte)
+        {
+            return s_dispatch.findByte(begin, end, byte);
+        }
+
+        const char * findControl(const char * begin, const char * end, const unsigned char limit)
+        {
+            return s_dispatch.findControl(begin, end, limit);
+        }
+
+        const char * byteScanInstructionSet()
+        {
+            return s_dispatch.instructionSet;
+        }
+
+    }
+
+}
@@ -0,0 +1,154 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include "wepp/priv/dateClock.hpp"
+#include <cstring>
+
+namespace Wepp
+{
+
+    namespace Priv
+    {
+
+        static const char s_dayNames[] = "ThuFriSatSunMonTueWed";
+        static const char s_monthNames[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+        static void formatTwoDigits(const unsigned int value, char * output)
+        {
+            output[0] = static_cast<char>('0' + value / 10);
+            output[1] = static_cast<char>('0' + value % 10);
+        }
+
+        const size_t DateClock::dateSize;
+
+        DateClock::DateClock() :
+            m_sequence(0),
+            m_second(0)
+        {
+            for (auto & word : m_words)
+            {
+                word.store(0, std::memory_order_relaxed);
+            }
+            m_updating.clear();
+            update(std::time(nullptr));
+        }
+
+        void DateClock::copy(char * output)
+        {
+            const std::time_t now = std::time(nullptr);
+            if (now != m_second.load(std::memory_order_acquire))
+            {
+                update(now);
+            }
+
+            // Retry while the date is being written, or was rewritten while copying.
+            uint64_t words[s_wordCount];
+            uint32_t sequence = 0;
+            do
+            {
+                sequence = m_sequence.load(std::memory_order_acquire);
+                for (size_t i = 0; i < s_wordCount; i++)
+                {
+                    words[i] = m_words[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+            } while ((sequence & 1) || sequence != m_sequence.load(std::memory_order_relaxed));
+
+            std::memcpy(output, words, dateSize);
+        }
+
+        void DateClock::format(const std::time_t time, char * output)
+        {
+            const int64_t seconds = static_cast<int64_t>(time);
+            int64_t days = seconds / 86400;
+            int64_t secondOfDay = seconds % 86400;
+            if (secondOfDay < 0)
+            {
+                secondOfDay += 86400;
+                days--;
+            }
+
+            // Civil date from days since epoch, in eras of 400 years starting at March 1st.
+            const int64_t shifted = days + 719468;
+            const int64_t era = (shifted >= 0 ? shifted : shifted - 146096) / 146097;
+            const unsigned int dayOfEra = static_cast<unsigned int>(shifted - era * 146097);
+            const unsigned int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+            const unsigned int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+            const unsigned int monthIndex = (5 * dayOfYear + 2) / 153;
+            const unsigned int day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+            const unsigned int month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+            const int64_t year = static_cast<int64_t>(yearOfEra) + era * 400 + (month <= 2 ? 1 : 0);
+
+            // Epoch was a Thursday.
+            const int64_t dayOfWeek = ((days % 7) + 7) % 7;
+            std::memcpy(output, s_dayNames + dayOfWeek * 3, 3);
+            output[3] = ',';
+            output[4] = ' ';
+            formatTwoDigits(day, output + 5);
+            output[7] = ' ';
+            std::memcpy(output + 8, s_monthNames + (month - 1) * 3, 3);
+            output[11] = ' ';
+            const unsigned int fourDigitYear = static_cast<unsigned int>(year % 10000);
+            formatTwoDigits(fourDigitYear / 100, output + 12);
+            formatTwoDigits(fourDigitYear % 100, output + 14);
+            output[16] = ' ';
+            formatTwoDigits(static_cast<unsigned int>(secondOfDay / 3600), output + 17);
+            output[19] = ':';
+            formatTwoDigits(static_cast<unsigned int>(secondOfDay / 60 % 60), output + 20);
+            output[22] = ':';
+            formatTwoDigits(static_cast<unsigned int>(secondOfDay % 60), output + 23);
+            std::memcpy(output + 25, " GMT", 4);
+        }
+
+        void DateClock::update(const std::time_t second)
+        {
+            // Readers keep copying the previous date while another thread renders the next one.
+            if (m_updating.test_and_set(std::memory_order_acquire))
+            {
+                return;
+            }
+
+            if (second != m_second.load(std::memory_order_relaxed))
+            {
+                uint64_t words[s_wordCount] = {};
+                format(second, reinterpret_cast<char *>(words));
+
+                const uint32_t sequence = m_sequence.load(std::memory_order_relaxed);
+                m_sequence.store(sequence + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                for (size_t i = 0; i < s_wordCount; i++)
+                {
+                    m_words[i].store(words[i], std::memory_order_relaxed);
+                }
+                m_sequence.store(sequence + 2, std::memory_order_release);
+                m_second.store(second, std::memory_order_release);
+            }
+
+            m_updating.clear(std::memory_order_release);
+        }
+
+    }
+
+}
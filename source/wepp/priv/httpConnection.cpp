@@ -0,0 +1,220 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include "wepp/priv/httpConnection.hpp"
+
+namespace Wepp
+{
+
+    namespace Priv
+    {
+
+        HttpConnection::HttpConnection(std::shared_ptr<Socket::TcpSocket> socket, const size_t bufferSize) :
+            m_socket(socket),
+            m_buffer(bufferSize),
+            m_routeCallback(nullptr),
+            m_requestCount(0),
+            m_lastActivity(std::chrono::steady_clock::now())
+        { }
+
+        Socket::TcpSocket & HttpConnection::socket()
+        {
+            return *m_socket;
+        }
+
+        HttpReceiverBuffer & HttpConnection::buffer()
+        {
+            return m_buffer;
+        }
+
+        HttpReceiver & HttpConnection::receiver()
+        {
+            return m_receiver;
+        }
+
+        Http::Request & HttpConnection::request()
+        {
+            return m_request;
+        }
+
+        Http::Response & HttpConnection::response()
+        {
+            return m_response;
+        }
+
+        const Http::RouteCallback * HttpConnection::routeCallback() const
+        {
+            return m_routeCallback;
+        }
+
+        void HttpConnection::routeCallback(const Http::RouteCallback * routeCallback)
+        {
+            m_routeCallback = routeCallback;
+        }
+
+        Http::RouteCaptures & HttpConnection::routeCaptures()
+        {
+            return m_routeCaptures;
+        }
+
+        void HttpConnection::routeSnapshot(std::shared_ptr<const Http::Router::Snapshot> snapshot)
+        {
+            m_routeSnapshot = std::move(snapshot);
+        }
+
+        void HttpConnection::resetRequest()
+        {
+            m_receiver.reset();
+            m_request.reset();
+            m_response.reset();
+            m_routeCallback = nullptr;
+            m_routeCaptures.reset();
+            m_routeSnapshot.reset();
+        }
+
+        HttpConnection::ReceiveStatus HttpConnection::receiveAvailable()
+        {
+            while (true)
+            {
+                const int result = m_buffer.receive(*m_socket);
+                if (result > 0)
+                {
+                    continue;
+                }
+                else if (result == 0)
+                {
+                    return ReceiveStatus::Disconnected;
+                }
+                else if (result == -2)
+                {
+                    return ReceiveStatus::BufferFull;
+                }
+
+                return Socket::Socket::wouldBlock() ? ReceiveStatus::Ok : ReceiveStatus::Error;
+            }
+        }
+
+        bool HttpConnection::send(const char * data, const size_t size, const std::chrono::duration<double> timeout)
+        {
+            size_t sent = 0;
+            while (sent < size)
+            {
+                const int result = m_socket->send(data + sent, static_cast<int>(size - sent));
+                if (result > 0)
+                {
+                    sent += static_cast<size_t>(result);
+                    continue;
+                }
+
+                if (result < 0 && Socket::Socket::wouldBlock() && m_socket->waitForWrite(timeout))
+                {
+                    continue;
+                }
+
+                return false;
+            }
+
+            return true;
+        }
+
+        bool HttpConnection::send(const Socket::SendBuffer * buffers, const size_t count, const std::chrono::duration<double> timeout)
+        {
+            size_t index = 0;
+            Socket::SendBuffer current = count ? buffers[0] : Socket::SendBuffer{ nullptr, 0 };
+            Socket::SendBuffer pending[Socket::TcpSocket::maxSendBuffers];
+
+            while (index < count)
+            {
+                // Skip empty and completely sent buffers.
+                if (current.size == 0)
+                {
+                    if (++index < count)
+                    {
+                        current = buffers[index];
+                    }
+                    continue;
+                }
+
+                pending[0] = current;
+                size_t pendingCount = 1;
+                while (pendingCount < Socket::TcpSocket::maxSendBuffers && index + pendingCount < count)
+                {
+                    pending[pendingCount] = buffers[index + pendingCount];
+                    pendingCount++;
+                }
+
+                const int result = m_socket->sendv(pending, pendingCount);
+                if (result > 0)
+                {
+                    // Advance past sent buffers, resuming a partially sent one.
+                    size_t sent = static_cast<size_t>(result);
+                    while (sent && sent >= current.size)
+                    {
+                        sent -= current.size;
+                        current.size = 0;
+                        if (++index < count)
+                        {
+                            current = buffers[index];
+                        }
+                    }
+                    current.data += sent;
+                    current.size -= sent;
+                    continue;
+                }
+
+                if (result < 0 && Socket::Socket::wouldBlock() && m_socket->waitForWrite(timeout))
+                {
+                    continue;
+                }
+
+                return false;
+            }
+
+            return true;
+        }
+
+        size_t HttpConnection::requestCount() const
+        {
+            return m_requestCount;
+        }
+
+        void HttpConnection::countRequest()
+        {
+            m_requestCount++;
+        }
+
+        void HttpConnection::touch()
+        {
+            m_lastActivity = std::chrono::steady_clock::now();
+        }
+
+        std::chrono::steady_clock::time_point HttpConnection::lastActivity() const
+        {
+            return m_lastActivity;
+        }
+
+    }
+
+}
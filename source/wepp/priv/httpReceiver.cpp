@@ -24,9 +24,9 @@
 */
 
 #include "wepp/priv/httpReceiver.hpp"
-#include <regex>
 #include <algorithm>
-#include <sstream>
+#include <cstring>
+#include <limits>
 
 namespace Wepp
 {
@@ -41,10 +41,7 @@ namespace Wepp
             m_receivedPosition(0),
             m_currentReceivePointer(m_buffer.get()),
             m_bufferEndPointer(m_buffer.get() + size),
-            m_currentPointer(m_buffer.get()),
-            m_newlinePointer(nullptr),
-            m_lastFindnewlinePointer(nullptr),
-            m_newlineResult(HttpReceiverBuffer::FindResult::NewlineNotFound)
+            m_currentPointer(m_buffer.get())
         {
             if (size == 0)
             {
@@ -58,9 +55,6 @@ namespace Wepp
             m_currentReceivePointer = m_buffer.get();
             m_bufferEndPointer = m_buffer.get() + m_bufferSize;
             m_currentPointer = m_buffer.get();
-            m_newlinePointer = nullptr;
-            m_lastFindnewlinePointer = nullptr;
-            m_newlineResult = HttpReceiverBuffer::FindResult::NewlineNotFound;
         }
 
         size_t HttpReceiverBuffer::size() const
@@ -75,14 +69,14 @@ namespace Wepp
 
         int HttpReceiverBuffer::receive(Socket::TcpSocket & socket)
         {
-            if (!makeSpace(0))
+            if (!makeSpace(1))
             {
                 return -2;
             }
 
             int result = socket.receive(m_currentReceivePointer, m_bufferSize - m_receivedPosition);
 
-            if (result)
+            if (result > 0)
             {
                 const size_t recvSize = static_cast<size_t>(result);
                 m_currentReceivePointer += recvSize;
@@ -107,129 +101,14 @@ namespace Wepp
             return true;
         }
 
-        HttpReceiverBuffer::FindResult HttpReceiverBuffer::readLine(std::string & output, const size_t maxLength)
+        const char * HttpReceiverBuffer::unreadData() const
         {
-            findNewline(maxLength);
-            if (m_newlineResult != FindResult::Found)
-            {
-                return m_newlineResult;
-            }
-            if (maxLength && static_cast<size_t>(m_newlinePointer - m_currentPointer) > maxLength)
-            {
-                return FindResult::ReachedMaxLength;
-            }
-
-            output = std::string(m_currentPointer, m_newlinePointer);
-
-            m_currentPointer = m_newlinePointer + 2;
-            m_newlinePointer = nullptr;
-            m_newlineResult = FindResult::NewlineNotFound;
-
-            return FindResult::Found;
-        }
-
-        HttpReceiverBuffer::FindResult HttpReceiverBuffer::regexSearch(std::cmatch & matches, const std::regex & regex, const size_t maxLength)
-        {
-            findNewline(maxLength);
-            if (m_newlineResult != FindResult::Found)
-            {
-                return m_newlineResult;
-            }
-            if (static_cast<size_t>(m_newlinePointer - m_currentPointer) > maxLength)
-            {
-                return FindResult::ReachedMaxLength;
-            }
-
-            if (std::regex_search(static_cast<const char *>(m_currentPointer), static_cast<const char *>(m_newlinePointer), matches, regex) == false)
-            {
-                return FindResult::RegexNotFound;
-            }
-
-            m_currentPointer = m_newlinePointer + 2;
-            m_newlinePointer = nullptr;
-            m_newlineResult = FindResult::NewlineNotFound;
-
-            return FindResult::Found;
-        }
-
-        HttpReceiverBuffer::FindResult HttpReceiverBuffer::readNewline()
-        {
-            if (static_cast<size_t>(m_bufferEndPointer - m_currentPointer) < 2 ||
-                *m_currentPointer != '\r' || *(m_currentPointer + 1) != '\n')
-            {
-                return FindResult::NewlineNotFound;
-            }
-
-            m_currentPointer += 2;
-            m_newlinePointer = nullptr;
-            m_newlineResult = FindResult::NewlineNotFound;
-
-            return FindResult::Found;
-        }
-
-        void HttpReceiverBuffer::findNewline(const size_t maxLength)
-        {
-            if (m_newlineResult == FindResult::Found)
-            {
-                return;
-            }
-
-            const bool useMaxLength = maxLength &&
-                                      (m_buffer.get() + maxLength <= m_bufferEndPointer) &&
-                                      (static_cast<size_t>(m_currentReceivePointer - m_currentPointer) > maxLength);
-
-            char * findFrom = m_lastFindnewlinePointer ? m_lastFindnewlinePointer : m_currentPointer;
-            char * findTo = useMaxLength ? m_currentPointer + maxLength : m_currentReceivePointer;
-
-            char * foundPos = std::find(findFrom, findTo, '\r');
-            if (foundPos == findTo)
-            {
-                m_lastFindnewlinePointer = foundPos;
-                m_newlineResult = useMaxLength ? FindResult::ReachedMaxLength : FindResult::NewlineNotFound;
-                return;
-            }
-            else if(*(foundPos + 1) != '\n')
-            {
-                m_lastFindnewlinePointer = foundPos;
-                m_newlineResult = FindResult::NewlineNotFound;
-                return;
-            }
-
-            m_lastFindnewlinePointer = nullptr;
-            m_newlinePointer = foundPos;
-            m_newlineResult = FindResult::Found;
+            return m_currentPointer;
         }
 
-        bool HttpReceiverBuffer::makeSpace()
+        void HttpReceiverBuffer::consume(const size_t size)
         {
-            if (m_currentReceivePointer != m_bufferEndPointer)
-            {
-                return true;
-            }
-
-            const size_t freeSpace = static_cast<size_t>(m_bufferEndPointer - m_currentReceivePointer);
-            const size_t moveSpace = static_cast<size_t>(m_currentPointer   - m_buffer.get());
-            const size_t availableSpace = freeSpace + moveSpace;
-            if (!availableSpace)
-            {
-                return false;
-            }
-
-            std::memcpy(m_buffer.get(), m_currentPointer, static_cast<size_t>(m_currentReceivePointer - m_currentPointer));
-
-            m_receivedPosition -= moveSpace;
-            m_currentReceivePointer -= moveSpace;
-            m_currentPointer = m_buffer.get();
-            if (m_newlinePointer)
-            {
-                m_newlinePointer -= moveSpace;
-            }
-            if (m_lastFindnewlinePointer)
-            {
-                m_lastFindnewlinePointer -= moveSpace;
-            }
-
-            return true;
+            m_currentPointer += std::min<size_t>(size, static_cast<size_t>(m_currentReceivePointer - m_currentPointer));
         }
 
         bool HttpReceiverBuffer::makeSpace(const size_t requiredSpace)
@@ -247,19 +126,11 @@ namespace Wepp
                 return false;
             }
 
-            std::memcpy(m_buffer.get(), m_currentPointer, static_cast<size_t>(m_currentReceivePointer - m_currentPointer));
+            std::memmove(m_buffer.get(), m_currentPointer, static_cast<size_t>(m_currentReceivePointer - m_currentPointer));
 
             m_receivedPosition -= moveSpace;
             m_currentReceivePointer -= moveSpace;
             m_currentPointer = m_buffer.get();
-            if (m_newlinePointer)
-            {
-                m_newlinePointer -= moveSpace;
-            }
-            if (m_lastFindnewlinePointer)
-            {
-                m_lastFindnewlinePointer -= moveSpace;
-            }
 
             return true;
         }
@@ -267,204 +138,185 @@ namespace Wepp
 
         // Http receiver implementation.
         HttpReceiver::HttpReceiver(const size_t limitRequestLine, const size_t limitHeaderFieldLine,
-                                   const size_t limitHeaderFieldCount, const size_t bufferSize) :
-            m_limitRequestLine(std::max<size_t>(limitRequestLine, 16) + 2),
-            m_limitHeaderFieldLine(std::max<size_t>(limitHeaderFieldLine, 8) + 2),
-            m_limitHeaderFieldCount(limitHeaderFieldCount),
-            m_bufferSize(std::max<size_t>(bufferSize, std::max<size_t>(m_limitRequestLine * 2, std::max<size_t>(m_limitHeaderFieldLine * 2, 1024)))),
-            m_buffer(m_bufferSize)
+                                   const size_t limitHeaderFieldCount) :
+            m_parser(limitRequestLine, limitHeaderFieldLine, limitHeaderFieldCount),
+            m_limitBodySize(std::numeric_limits<uint64_t>::max()),
+            m_state(State::Head),
+            m_remaining(0)
         { }
 
-        HttpReceiver::Status HttpReceiver::receive(std::shared_ptr<Socket::TcpSocket> socket,
-                                                   Http::Request & request, Http::Response & response,
-                                                   std::function<bool(Http::Request &, Http::Response &)> onRequest)
+        void HttpReceiver::reset()
         {
-            response.status(Http::Status::Ok);
+            m_parser.reset();
+            m_state = State::Head;
+            m_remaining = 0;
+        }
 
-            enum class State
+        HttpReceiver::Status HttpReceiver::parse(HttpReceiverBuffer & buffer, Http::Request & request, Http::Response & response,
+                                                 std::function<bool(Http::Request &, Http::Response &)> onRequest,
+                                                 std::function<bool(Http::Request &, Http::Response &, const StringView &)> onData)
+        {
+            auto deliver = [&request, &response, &onData](const StringView & data) -> bool
             {
-                RequestLine,
-                Headers,
-                Body
+                if (!onData)
+                {
+                    if (request.body().append(data.data(), data.size()).failed())
+                    {
+                        response.status(Http::Status::InsufficientStorage);
+                        return false;
+                    }
+                    return true;
+                }
+                return onData(request, response, data);
             };
 
-            State state = State::RequestLine;
-            int recvSize = 0;
-            size_t contentLength = 0;
-            bool foundContentLengthHeader = false;
-            size_t headerCount = 0;
-
-            // Make sure to reset the buffer, due to possibility of multiple calls of this function.
-            m_buffer.reset();
-
-            // Parse request line.
-            while(state == State::RequestLine)
+            // Parse request line and headers.
+            if (m_state == State::Head)
             {
-                recvSize = m_buffer.receive(*socket);
-                if (recvSize == 0)
-                {
-                    return Status::Disconnected;
-                }
-                else if (recvSize < 0)
+                while (true)
                 {
-                    response.status(Http::Status::InternalServerError);
-                    return Status::InternalError;
-                }
+                    size_t consumed = 0;
+                    const auto result = m_parser.execute(buffer.unreadData(), buffer.unreadBytes(), consumed, request);
+                    buffer.consume(consumed);
 
-                std::cmatch matches;
-                static const std::regex findRequestLineRegex(R"(^([^ ]*) (.*) ([^ ]*)$)");
-                auto foundRequestLine = m_buffer.regexSearch(matches, findRequestLineRegex, m_limitRequestLine);
-                if (foundRequestLine == HttpReceiverBuffer::FindResult::ReachedMaxLength)
-                {
-                    response.status(Http::Status::UriTooLong);
-                    return Status::PeerError;
-                }
-                else if (foundRequestLine == HttpReceiverBuffer::FindResult::RegexNotFound)
-                {
-                    response.status(Http::Status::BadRequest);
-                    return Status::PeerError;
-                }
-                else if (foundRequestLine == HttpReceiverBuffer::FindResult::NewlineNotFound)
-                {
-                    continue;
-                }
+                    if (result == Http::HttpParser::Result::Complete)
+                    {
+                        break;
+                    }
+                    else if (result == Http::HttpParser::Result::Error)
+                    {
+                        response.status(m_parser.error());
+                        return finish(Status::PeerError);
+                    }
+                    else if (result == Http::HttpParser::Result::RequestLine)
+                    {
+                        if (!onRequest(request, response))
+                        {
+                            return finish(Status::PeerError);
+                        }
+                        continue;
+                    }
 
-                request.method(std::string(matches[1].first, matches[1].second));
-                request.resource(std::string(matches[2].first, matches[2].second));
-                std::string version(matches[3].first, matches[3].second);
-                if (version != "HTTP/1.1")
-                {
-                    response.status(Http::Status::HttpVersionNotSupported);
-                    return Status::PeerError;
-                }
+                    // A line filling the whole buffer can never be completed.
+                    if (buffer.unreadBytes() == buffer.size())
+                    {
+                        response.status(Http::Status::RequestHeaderFieldsTooLarge);
+                        return finish(Status::PeerError);
+                    }
 
-                if (!onRequest(request, response))
-                {
-                    return Status::PeerError;
+                    // Receiving may move buffered data, invalidating views of the request.
+                    request.materialize();
+                    return Status::NeedMore;
                 }
 
-                state = State::Headers;
-            }
-
-            while (state == State::Headers)
-            {
-                if (headerCount > m_limitHeaderFieldCount)
+                // See: https://tools.ietf.org/html/rfc7230#section-3.3.3
+                m_remaining = m_parser.contentLength();
+                if (m_remaining > m_limitBodySize)
                 {
-                    response.status(Http::Status::BadRequest);
-                    return Status::PeerError;
+                    response.status(Http::Status::PayloadTooLarge);
+                    return finish(Status::PeerError);
                 }
 
-                std::cmatch matches;
-                static const std::regex findHeaderLineRegex(R"(^([^\:]*?)(\s*):(?:\s*)?(.*?)(?:\s*)?$)");
-                auto foundHeaderLine = m_buffer.regexSearch(matches, findHeaderLineRegex, m_limitRequestLine);
-                if (foundHeaderLine == HttpReceiverBuffer::FindResult::ReachedMaxLength)
-                {
-                    response.status(Http::Status::RequestHeaderFieldsTooLarge);
-                    return Status::PeerError;
-                }
-                else if (foundHeaderLine == HttpReceiverBuffer::FindResult::RegexNotFound)
+                m_state = m_parser.chunked() ? State::ChunkedBody : State::Body;
+                if (m_state == State::ChunkedBody)
                 {
-                    response.status(Http::Status::BadRequest);
-                    return Status::PeerError;
+                    m_chunkedDecoder.reset();
                 }
-                else if (foundHeaderLine == HttpReceiverBuffer::FindResult::NewlineNotFound)
+
+                // The request is accepted at this point, ask the client to send the body.
+                // See: https://tools.ietf.org/html/rfc7231#section-5.1.1
+                const StringView expect = request.header(Http::HeaderId::Expect);
+                if (!expect.empty())
                 {
-                    recvSize = m_buffer.receive(*socket);
-                    if (recvSize == 0)
+                    if (!expect.equalsIgnoreCase("100-continue"))
                     {
-                        return Status::Disconnected;
+                        response.status(Http::Status::ExpectationFailed);
+                        return finish(Status::PeerError);
                     }
-                    else if (recvSize < 0)
+
+                    if ((m_remaining || m_state == State::ChunkedBody) && !buffer.unreadBytes())
                     {
-                        response.status(Http::Status::InternalServerError);
-                        return Status::InternalError;
+                        request.materialize();
+                        return Status::ExpectContinue;
                     }
-                    continue;
                 }
+            }
 
-                // Now allowing space before colon.
-                // See: https://tools.ietf.org/html/rfc7230#section-3.2.4
-                if (std::string(matches[2].first, matches[2].second).size() != 0)
+            // Decode chunked body, delivering chunks straight from the buffer.
+            if (m_state == State::ChunkedBody)
+            {
+                while (true)
                 {
-                    response.status(Http::Status::BadRequest);
-                    return Status::PeerError;
-                }
+                    size_t consumed = 0;
+                    StringView chunk;
+                    const auto result = m_chunkedDecoder.execute(buffer.unreadData(), buffer.unreadBytes(), consumed, chunk);
+                    buffer.consume(consumed);
 
-                std::string fieldName = std::string(matches[1].first, matches[1].second);
-                std::transform(fieldName.begin(), fieldName.end(), fieldName.begin(), [](int c) -> char {return static_cast<char>(::tolower(c)); });
-                std::string fieldValue = std::string(matches[3].first, matches[3].second);
-
-                // Parse content-length.
-                if (fieldName == "content-length")
-                {
-                    // Parse value.
-                    std::stringstream ss(fieldValue);
-                    size_t tempContentLength = 0;
-                    ss >> tempContentLength;
-                    if (ss.fail())
+                    if (result == Http::ChunkedDecoder::Result::Data)
                     {
-                        response.status(Http::Status::BadRequest);
-                        return Status::PeerError;
+                        if (m_chunkedDecoder.bodySize() > m_limitBodySize)
+                        {
+                            response.status(Http::Status::PayloadTooLarge);
+                            return finish(Status::PeerError);
+                        }
+                        if (!deliver(chunk))
+                        {
+                            return finish(Status::PeerError);
+                        }
+                        continue;
                     }
-
-                    // Do not allow multiple content-length fields with different values.
-                    if (foundContentLengthHeader && contentLength != tempContentLength)
+                    else if (result == Http::ChunkedDecoder::Result::Complete)
+                    {
+                        return finish(Status::Ok);
+                    }
+                    else if (result == Http::ChunkedDecoder::Result::Error)
                     {
-                        response.status(Http::Status::BadRequest);
-                        return Status::PeerError;
+                        response.status(m_chunkedDecoder.error());
+                        return finish(Status::PeerError);
                     }
 
-                    contentLength = tempContentLength;
-                    foundContentLengthHeader = true;
+                    request.materialize();
+                    return Status::NeedMore;
                 }
-                // Chunked request is not yet supported
-                else if (fieldName == "transfer-encoding")
+            }
+
+            // Deliver content-length body.
+            while (m_remaining)
+            {
+                const size_t available = static_cast<size_t>(std::min<uint64_t>(buffer.unreadBytes(), m_remaining));
+                if (!available)
                 {
-                    response.status(Http::Status::NotAcceptable);
-                    return Status::PeerError;
+                    request.materialize();
+                    return Status::NeedMore;
                 }
 
-                request.headers()[fieldName] = fieldValue;
-                headerCount++;
+                const StringView data(buffer.unreadData(), available);
+                buffer.consume(available);
+                m_remaining -= available;
 
-                if (m_buffer.readNewline() == HttpReceiverBuffer::FindResult::Found)
+                if (!deliver(data))
                 {
-                    state = State::Body;
-                    continue;
+                    return finish(Status::PeerError);
                 }
-
             }
 
-            // Parse body if it's present in request.
-            // See: https://tools.ietf.org/html/rfc7230#section-3.3.3
-            bool bodyIsPresent = contentLength > 0;
-            if (bodyIsPresent)
-            {
-                size_t totalReceived = 0;
-                do
-                {
-                    totalReceived += m_buffer.readAll(request.body());
-
-                    if (totalReceived == contentLength)
-                    {
-                        break;
-                    }
+            return finish(Status::Ok);
+        }
 
-                    recvSize = m_buffer.receive(*socket);
-                    if (recvSize == 0)
-                    {
-                        return Status::Disconnected;
-                    }
-                    else if (recvSize < 0)
-                    {
-                        response.status(Http::Status::InternalServerError);
-                        return Status::InternalError;
-                    }
+        void HttpReceiver::limitBodySize(const uint64_t limit)
+        {
+            m_limitBodySize = limit;
+        }
 
-                } while (state == State::Body);
-            }
+        uint64_t HttpReceiver::limitBodySize() const
+        {
+            return m_limitBodySize;
+        }
 
-            return Status::Ok;
+        HttpReceiver::Status HttpReceiver::finish(const Status status)
+        {
+            reset();
+            return status;
         }
 
     }
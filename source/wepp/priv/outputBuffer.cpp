@@ -0,0 +1,169 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include "wepp/priv/outputBuffer.hpp"
+#include <cstring>
+
+namespace Wepp
+{
+
+    namespace Priv
+    {
+
+        static const char s_digitPairs[] =
+            "00010203040506070809"
+            "10111213141516171819"
+            "20212223242526272829"
+            "30313233343536373839"
+            "40414243444546474849"
+            "50515253545556575859"
+            "60616263646566676869"
+            "70717273747576777879"
+            "80818283848586878889"
+            "90919293949596979899";
+
+        size_t formatInteger(uint64_t value, char * output)
+        {
+            // Digits are written backwards into a scratch buffer, then copied in order.
+            char digits[maxIntegerDigits];
+            char * position = digits + maxIntegerDigits;
+
+            while (value >= 100)
+            {
+                const size_t pair = static_cast<size_t>(value % 100) * 2;
+                value /= 100;
+                position -= 2;
+                position[0] = s_digitPairs[pair];
+                position[1] = s_digitPairs[pair + 1];
+            }
+            if (value >= 10)
+            {
+                const size_t pair = static_cast<size_t>(value) * 2;
+                position -= 2;
+                position[0] = s_digitPairs[pair];
+                position[1] = s_digitPairs[pair + 1];
+            }
+            else
+            {
+                *--position = static_cast<char>('0' + value);
+            }
+
+            const size_t length = static_cast<size_t>(digits + maxIntegerDigits - position);
+            std::memcpy(output, position, length);
+            return length;
+        }
+
+        OutputBuffer::OutputBuffer(const size_t capacity) :
+            m_data(new char[capacity > 0 ? capacity : 1]),
+            m_size(0),
+            m_capacity(capacity > 0 ? capacity : 1)
+        { }
+
+        void OutputBuffer::append(const char * data, const size_t size)
+        {
+            if (size == 0)
+            {
+                return;
+            }
+            reserve(size);
+            std::memcpy(m_data.get() + m_size, data, size);
+            m_size += size;
+        }
+
+        void OutputBuffer::append(const StringView & data)
+        {
+            append(data.data(), data.size());
+        }
+
+        char * OutputBuffer::extend(const size_t size)
+        {
+            reserve(size);
+            char * data = m_data.get() + m_size;
+            m_size += size;
+            return data;
+        }
+
+        void OutputBuffer::appendInteger(const uint64_t value)
+        {
+            reserve(maxIntegerDigits);
+            m_size += formatInteger(value, m_data.get() + m_size);
+        }
+
+        const char * OutputBuffer::data() const
+        {
+            return m_data.get();
+        }
+
+        size_t OutputBuffer::size() const
+        {
+            return m_size;
+        }
+
+        size_t OutputBuffer::capacity() const
+        {
+            return m_capacity;
+        }
+
+        bool OutputBuffer::empty() const
+        {
+            return m_size == 0;
+        }
+
+        void OutputBuffer::clear()
+        {
+            m_size = 0;
+        }
+
+        void OutputBuffer::shrink(const size_t capacity)
+        {
+            if (m_size == 0 && capacity > 0 && m_capacity > capacity)
+            {
+                m_data.reset(new char[capacity]);
+                m_capacity = capacity;
+            }
+        }
+
+        void OutputBuffer::reserve(const size_t additional)
+        {
+            if (m_capacity - m_size >= additional)
+            {
+                return;
+            }
+
+            size_t capacity = m_capacity * 2;
+            while (capacity - m_size < additional)
+            {
+                capacity *= 2;
+            }
+
+            std::unique_ptr<char[]> data(new char[capacity]);
+            std::memcpy(data.get(), m_data.get(), m_size);
+            m_data = std::move(data);
+            m_capacity = capacity;
+        }
+
+    }
+
+}
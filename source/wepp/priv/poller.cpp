@@ -0,0 +1,242 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include "wepp/priv/poller.hpp"
+#include <stdexcept>
+#if defined(WEPP_PLATFORM_LINUX)
+    #include <sys/epoll.h>
+    #include <sys/eventfd.h>
+#elif defined(WEPP_PLATFORM_WINDOWS)
+    #include <algorithm>
+    #include <thread>
+#endif
+
+namespace Wepp
+{
+
+    namespace Priv
+    {
+
+    #if defined(WEPP_PLATFORM_LINUX)
+
+        static const size_t s_maxEvents = 256;
+
+        Poller::Poller() :
+            m_epoll(::epoll_create1(EPOLL_CLOEXEC)),
+            m_interruptEvent(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+        {
+            if (m_epoll < 0 || m_interruptEvent < 0)
+            {
+                throw std::runtime_error("Failed to create epoll poller.");
+            }
+
+            epoll_event event = {};
+            event.events = EPOLLIN | EPOLLET;
+            event.data.ptr = this;
+            if (::epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_interruptEvent, &event) != 0)
+            {
+                throw std::runtime_error("Failed to register interrupt event of epoll poller.");
+            }
+        }
+
+        Poller::~Poller()
+        {
+            ::close(m_interruptEvent);
+            ::close(m_epoll);
+        }
+
+        bool Poller::add(const Socket::Socket::Handle handle, void * data, const bool oneShot)
+        {
+            epoll_event event = {};
+            event.events = EPOLLIN | EPOLLRDHUP | EPOLLET | (oneShot ? EPOLLONESHOT : 0);
+            event.data.ptr = data;
+            return ::epoll_ctl(m_epoll, EPOLL_CTL_ADD, handle, &event) == 0;
+        }
+
+        bool Poller::rearm(const Socket::Socket::Handle handle, void * data)
+        {
+            epoll_event event = {};
+            event.events = EPOLLIN | EPOLLRDHUP | EPOLLET | EPOLLONESHOT;
+            event.data.ptr = data;
+            return ::epoll_ctl(m_epoll, EPOLL_CTL_MOD, handle, &event) == 0;
+        }
+
+        bool Poller::remove(const Socket::Socket::Handle handle)
+        {
+            return ::epoll_ctl(m_epoll, EPOLL_CTL_DEL, handle, nullptr) == 0;
+        }
+
+        size_t Poller::wait(std::vector<Event> & events, const std::chrono::duration<double> timeout)
+        {
+            events.clear();
+
+            epoll_event nativeEvents[s_maxEvents];
+            const int timeoutMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(timeout).count());
+            const int count = ::epoll_wait(m_epoll, nativeEvents, static_cast<int>(s_maxEvents), timeoutMs);
+            if (count <= 0)
+            {
+                return 0;
+            }
+
+            for (int i = 0; i < count; i++)
+            {
+                const epoll_event & nativeEvent = nativeEvents[i];
+                if (nativeEvent.data.ptr == this)
+                {
+                    uint64_t value = 0;
+                    while (::read(m_interruptEvent, &value, sizeof(value)) > 0)
+                    { }
+                    continue;
+                }
+
+                Event event;
+                event.data = nativeEvent.data.ptr;
+                event.readable = (nativeEvent.events & EPOLLIN) != 0;
+                event.closed = (nativeEvent.events & (EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0;
+                events.push_back(event);
+            }
+
+            return events.size();
+        }
+
+        void Poller::interrupt()
+        {
+            const uint64_t value = 1;
+            if (::write(m_interruptEvent, &value, sizeof(value)) < 0)
+            {
+                // Counter overflow, the poller is already interrupted.
+            }
+        }
+
+    #elif defined(WEPP_PLATFORM_WINDOWS)
+
+        static const std::chrono::milliseconds s_pollSlice(50);
+
+        Poller::Poller() :
+            m_interrupted(false)
+        { }
+
+        Poller::~Poller()
+        { }
+
+        bool Poller::add(const Socket::Socket::Handle handle, void * data, const bool oneShot)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_entries.insert({ handle, Entry{ data, oneShot, true } }).second;
+        }
+
+        bool Poller::rearm(const Socket::Socket::Handle handle, void * data)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_entries.find(handle);
+            if (it == m_entries.end())
+            {
+                return false;
+            }
+            it->second.data = data;
+            it->second.armed = true;
+            return true;
+        }
+
+        bool Poller::remove(const Socket::Socket::Handle handle)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_entries.erase(handle) != 0;
+        }
+
+        size_t Poller::wait(std::vector<Event> & events, const std::chrono::duration<double> timeout)
+        {
+            events.clear();
+
+            // WSAPoll cannot be woken up by other threads, poll in slices and check the interrupt flag.
+            const auto end = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout);
+            std::vector<WSAPOLLFD> descriptors;
+            while (!m_interrupted.exchange(false))
+            {
+                descriptors.clear();
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    for (auto it = m_entries.begin(); it != m_entries.end(); it++)
+                    {
+                        if (it->second.armed)
+                        {
+                            descriptors.push_back({ it->first, POLLRDNORM, 0 });
+                        }
+                    }
+                }
+
+                const auto now = std::chrono::steady_clock::now();
+                if (now >= end)
+                {
+                    break;
+                }
+                const auto slice = std::min<std::chrono::milliseconds>(s_pollSlice, std::chrono::duration_cast<std::chrono::milliseconds>(end - now));
+
+                if (descriptors.empty())
+                {
+                    std::this_thread::sleep_for(slice);
+                    continue;
+                }
+                if (::WSAPoll(descriptors.data(), static_cast<ULONG>(descriptors.size()), static_cast<INT>(slice.count())) <= 0)
+                {
+                    continue;
+                }
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                for (auto & descriptor : descriptors)
+                {
+                    auto it = m_entries.find(descriptor.fd);
+                    if (!descriptor.revents || it == m_entries.end() || !it->second.armed)
+                    {
+                        continue;
+                    }
+
+                    Event event;
+                    event.data = it->second.data;
+                    event.readable = (descriptor.revents & POLLRDNORM) != 0;
+                    event.closed = (descriptor.revents & (POLLHUP | POLLERR)) != 0;
+                    events.push_back(event);
+
+                    if (it->second.oneShot)
+                    {
+                        it->second.armed = false;
+                    }
+                }
+                break;
+            }
+
+            return events.size();
+        }
+
+        void Poller::interrupt()
+        {
+            m_interrupted = true;
+        }
+
+    #endif
+
+    }
+
+}
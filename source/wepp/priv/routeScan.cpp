@@ -0,0 +1,291 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+#include "wepp/priv/routeScan.hpp"
+#include <algorithm>
+#include <limits>
+#include <cstring>
+
+namespace Wepp
+{
+
+    namespace Priv
+    {
+
+        static bool isHexDigit(const char c)
+        {
+            return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+        }
+
+        bool parseTypedTag(const StringView & tag, StringView & name, Http::RouteParameter::Type & type)
+        {
+            static const std::pair<StringView, Http::RouteParameter::Type> s_types[] =
+            {
+                { "int", Http::RouteParameter::Type::Int },
+                { "uuid", Http::RouteParameter::Type::Uuid },
+                { "slug", Http::RouteParameter::Type::Slug },
+                { "str", Http::RouteParameter::Type::String },
+                { "path*", Http::RouteParameter::Type::Path }
+            };
+
+            const size_t colon = tag.find(':');
+            const StringView typeName = colon == StringView::npos ? tag : tag.substr(colon + 1);
+            auto it = std::find_if(std::begin(s_types), std::end(s_types), [&typeName](const std::pair<StringView, Http::RouteParameter::Type> & pair)
+            {
+                return typeName == pair.first;
+            });
+            if (it == std::end(s_types) || colon == 0)
+            {
+                return false;
+            }
+
+            // Names are identifiers, anything else is a regex.
+            const StringView tagName = colon == StringView::npos ? StringView() : tag.substr(0, colon);
+            for (size_t i = 0; i < tagName.size(); i++)
+            {
+                const char c = tagName[i];
+                if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || (i > 0 && c >= '0' && c <= '9')))
+                {
+                    return false;
+                }
+            }
+
+            name = tagName;
+            type = it->second;
+            return true;
+        }
+
+        bool scanRouteValue(const Http::RouteParameter::Type type, const char * begin, const char * end, int64_t & integer)
+        {
+            switch (type)
+            {
+                case Http::RouteParameter::Type::Int:
+                {
+                    const bool negative = begin != end && *begin == '-';
+                    begin += negative ? 1 : 0;
+                    if (begin == end)
+                    {
+                        return false;
+                    }
+
+                    const uint64_t limit = static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + (negative ? 1 : 0);
+                    uint64_t value = 0;
+                    for (; begin != end; begin++)
+                    {
+                        const uint64_t digit = static_cast<uint64_t>(static_cast<unsigned char>(*begin) - '0');
+                        if (digit > 9 || value > (limit - digit) / 10)
+                        {
+                            return false;
+                        }
+                        value = value * 10 + digit;
+                    }
+
+                    integer = !negative ? static_cast<int64_t>(value) : (value ? -static_cast<int64_t>(value - 1) - 1 : 0);
+                    return true;
+                }
+                case Http::RouteParameter::Type::Uuid:
+                {
+                    if (end - begin != 36)
+                    {
+                        return false;
+                    }
+                    for (size_t i = 0; i < 36; i++)
+                    {
+                        const bool hyphen = i == 8 || i == 13 || i == 18 || i == 23;
+                        if (hyphen ? begin[i] != '-' : !isHexDigit(begin[i]))
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+                case Http::RouteParameter::Type::Slug:
+                {
+                    return begin != end && std::all_of(begin, end, [](const char c)
+                    {
+                        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_';
+                    });
+                }
+                default: break;
+            }
+            return true;
+        }
+
+        const char * findTagEnd(const char * begin, const char * end)
+        {
+            while (begin < end && *begin != '>')
+            {
+                begin += *begin == '\\' ? 2 : 1;
+            }
+            return std::min(begin, end);
+        }
+
+        // Route pattern class.
+        RoutePattern::RoutePattern() :
+            m_pattern(""),
+            m_size(0),
+            m_valid(false)
+        { }
+
+        RoutePattern::RoutePattern(const char * pattern) :
+            m_pattern(pattern),
+            m_size(0),
+            m_valid(false)
+        {
+            const size_t size = std::strlen(pattern);
+            if (size > std::numeric_limits<uint16_t>::max())
+            {
+                return;
+            }
+
+            const char * patternEnd = pattern + size;
+            const char * position = pattern;
+            position += position != patternEnd && *position == '/' ? 1 : 0;
+            size_t tagCount = 0;
+
+            while (position != patternEnd)
+            {
+                Segment segment = {};
+                if (*position != '<')
+                {
+                    const char * literal = position;
+                    while (position != patternEnd && *position != '<')
+                    {
+                        position++;
+                    }
+                    segment.literal = static_cast<uint16_t>(literal - pattern);
+                    segment.literalSize = static_cast<uint16_t>(position - literal);
+                    if (!add(segment))
+                    {
+                        return;
+                    }
+                    continue;
+                }
+
+                const char * tagEnd = findTagEnd(position + 1, patternEnd);
+                const StringView tag(position + 1, static_cast<size_t>(tagEnd - position - 1));
+                StringView name;
+                Http::RouteParameter::Type type = Http::RouteParameter::Type::String;
+                if (tagEnd == patternEnd || (!tag.empty() && !parseTypedTag(tag, name, type)) ||
+                    ++tagCount > Http::RouteCaptures::capacity)
+                {
+                    return;
+                }
+                position = tagEnd + 1;
+
+                // Literal text following the tag in its directory ends the value.
+                const char * literal = position;
+                while (position != patternEnd && *position != '/' && *position != '<')
+                {
+                    position++;
+                }
+                if (position != patternEnd && *position == '<')
+                {
+                    return;
+                }
+
+                segment.literal = static_cast<uint16_t>(literal - pattern);
+                segment.literalSize = static_cast<uint16_t>(position - literal);
+                segment.name = static_cast<uint16_t>(name.empty() ? 0 : name.data() - pattern);
+                segment.nameSize = static_cast<uint16_t>(name.size());
+                segment.type = type;
+                segment.tag = true;
+                if (!add(segment))
+                {
+                    return;
+                }
+            }
+
+            m_valid = true;
+        }
+
+        bool RoutePattern::valid() const
+        {
+            return m_valid;
+        }
+
+        bool RoutePattern::match(const StringView & path, Http::RouteCaptures & captures) const
+        {
+            captures.reset(path.data());
+            if (!m_valid)
+            {
+                return false;
+            }
+
+            const char * position = path.begin();
+            const char * end = path.end();
+            position += position != end && *position == '/' ? 1 : 0;
+
+            for (size_t i = 0; i < m_size; i++)
+            {
+                const Segment & segment = m_segments[i];
+                const char * literal = m_pattern + segment.literal;
+                if (!segment.tag)
+                {
+                    if (static_cast<size_t>(end - position) < segment.literalSize ||
+                        std::memcmp(position, literal, segment.literalSize) != 0)
+                    {
+                        return false;
+                    }
+                    position += segment.literalSize;
+                    continue;
+                }
+
+                const char * dirEnd = end;
+                if (segment.type != Http::RouteParameter::Type::Path)
+                {
+                    dirEnd = std::find(position, end, '/');
+                }
+                if (static_cast<size_t>(dirEnd - position) < segment.literalSize ||
+                    std::memcmp(dirEnd - segment.literalSize, literal, segment.literalSize) != 0)
+                {
+                    return false;
+                }
+
+                int64_t integer = 0;
+                const char * valueEnd = dirEnd - segment.literalSize;
+                if (!scanRouteValue(segment.type, position, valueEnd, integer))
+                {
+                    return false;
+                }
+                captures.add(StringView(m_pattern + segment.name, segment.nameSize), segment.type, position, valueEnd, integer);
+                position = dirEnd;
+            }
+
+            return position == end;
+        }
+
+        bool RoutePattern::add(const Segment & segment)
+        {
+            if (m_size == s_maxSegments)
+            {
+                return false;
+            }
+            m_segments[m_size++] = segment;
+            return true;
+        }
+
+    }
+
+}
@@ -52,6 +52,15 @@ namespace Wepp
         #endif
         }
 
+        bool Socket::wouldBlock()
+        {
+        #if defined(WEPP_PLATFORM_WINDOWS)
+            return ::WSAGetLastError() == WSAEWOULDBLOCK;
+        #elif defined(WEPP_PLATFORM_LINUX)
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        #endif
+        }
+
         Socket::Socket() :
             m_handle(0)
         { }
@@ -99,8 +108,8 @@ namespace Wepp
                         return false;
                     }
 
-                    // Toggle the non blocking flag.
-                    opts ^= O_NONBLOCK;
+                    // Set or clear the non blocking flag.
+                    opts = status ? (opts & ~O_NONBLOCK) : (opts | O_NONBLOCK);
 
                     // Try to set the new file descriptor.
                     int result = 0;
@@ -120,6 +129,40 @@ namespace Wepp
         }
 
 
+        static bool waitForEvent(const Socket::Handle handle, const short events, const std::chrono::duration<double> timeout)
+        {
+            const int timeoutMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(timeout).count());
+
+            #if defined(WEPP_PLATFORM_WINDOWS)
+                WSAPOLLFD pollDescriptor = { handle, events, 0 };
+                return ::WSAPoll(&pollDescriptor, 1, timeoutMs) > 0;
+            #elif defined(WEPP_PLATFORM_LINUX)
+                pollfd pollDescriptor = { handle, events, 0 };
+                int result = 0;
+                while ((result = ::poll(&pollDescriptor, 1, timeoutMs)) < 0 && errno == EINTR)
+                { }
+                return result > 0;
+            #endif
+        }
+
+        bool Socket::waitForRead(const std::chrono::duration<double> timeout) const
+        {
+            #if defined(WEPP_PLATFORM_WINDOWS)
+                return waitForEvent(m_handle, POLLRDNORM, timeout);
+            #elif defined(WEPP_PLATFORM_LINUX)
+                return waitForEvent(m_handle, POLLIN, timeout);
+            #endif
+        }
+
+        bool Socket::waitForWrite(const std::chrono::duration<double> timeout) const
+        {
+            #if defined(WEPP_PLATFORM_WINDOWS)
+                return waitForEvent(m_handle, POLLWRNORM, timeout);
+            #elif defined(WEPP_PLATFORM_LINUX)
+                return waitForEvent(m_handle, POLLOUT, timeout);
+            #endif
+        }
+
         Socket & Socket::operator = (const Handle & handle)
         {
             m_handle = handle;
@@ -0,0 +1,199 @@
+/*
+* MIT License
+*
+* Copyright (c) 2019 Jimmie Bergmann
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*/
+
+#include "wepp/socket/tcpAcceptor.hpp"
+#include "wepp/socket/platform/socketFunctions.hpp"
+
+namespace Wepp
+{
+
+    namespace Socket
+    {
+
+        #if defined(WEPP_PLATFORM_LINUX)
+            // Errors of accept4 caused by the pending connection rather than the listening socket.
+            static bool isAcceptRetryable(const int error)
+            {
+                return error == EINTR || error == ECONNABORTED || error == EPROTO || error == ENETDOWN ||
+                       error == ENOPROTOOPT || error == EHOSTDOWN || error == ENONET || error == EHOSTUNREACH ||
+                       error == EOPNOTSUPP || error == ENETUNREACH;
+            }
+        #endif
+
+        TcpAcceptor::TcpAcceptor()
+        #if defined(WEPP_PLATFORM_LINUX)
+            : m_reserve(-1)
+        #endif
+        { }
+
+        TcpAcceptor::~TcpAcceptor()
+        {
+            close();
+        }
+
+        bool TcpAcceptor::open(const uint16_t port, const std::string & endpoint)
+        {
+            if (m_handle)
+            {
+                return false;
+            }
+
+            // Get address as integer.
+            uint32_t endpointAddr = htonl(INADDR_ANY);
+            if (endpoint.size() && inet_pton(AF_INET, endpoint.c_str(), &endpointAddr) != 1)
+            {
+                return false;
+            }
+
+            // Create listen socket.
+            m_handle = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+            if (WeppIsSocketInvalid(m_handle))
+            {
+                m_handle = 0;
+                return false;
+            }
+
+            #if defined(WEPP_PLATFORM_LINUX)
+                // Allow rebinding the port while old connections are in TIME_WAIT.
+                const int reuseAddress = 1;
+                ::setsockopt(m_handle, SOL_SOCKET, SO_REUSEADDR, &reuseAddress, sizeof(reuseAddress));
+            #endif
+
+            // Bind listen socket.
+            sockaddr_in service;
+            service.sin_family = AF_INET;
+            service.sin_addr.s_addr = endpointAddr;
+            service.sin_port = htons(port);
+
+            if (::bind(m_handle, reinterpret_cast<const WEPP_SOCKADDR_TYPE *>(&service), sizeof(service)) != 0 ||
+                ::listen(m_handle, SOMAXCONN) != 0 ||
+                !setBlocking(false))
+            {
+                close();
+                return false;
+            }
+
+            #if defined(WEPP_PLATFORM_LINUX)
+                m_reserve = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+            #endif
+
+            return true;
+        }
+
+        void TcpAcceptor::close()
+        {
+            if (m_handle)
+            {
+                WeppCloseSocket(m_handle);
+                m_handle = 0;
+            }
+
+            #if defined(WEPP_PLATFORM_LINUX)
+                if (m_reserve >= 0)
+                {
+                    ::close(m_reserve);
+                    m_reserve = -1;
+                }
+            #endif
+        }
+
+        std::shared_ptr<TcpSocket> TcpAcceptor::accept()
+        {
+            AcceptStatus status;
+            return accept(status);
+        }
+
+        std::shared_ptr<TcpSocket> TcpAcceptor::accept(AcceptStatus & status)
+        {
+            status = AcceptStatus::Error;
+            if (!m_handle)
+            {
+                return nullptr;
+            }
+
+            Handle connection = 0;
+            #if defined(WEPP_PLATFORM_LINUX)
+                do
+                {
+                    connection = ::accept4(m_handle, NULL, NULL, SOCK_NONBLOCK);
+                } while (WeppIsSocketInvalid(connection) && isAcceptRetryable(errno));
+
+                if (WeppIsSocketInvalid(connection))
+                {
+                    if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    {
+                        status = AcceptStatus::WouldBlock;
+                    }
+                    else if ((errno == EMFILE || errno == ENFILE) && m_reserve >= 0)
+                    {
+                        // Shed the pending connection with the reserved descriptor, then reserve it again.
+                        // Descriptors are allocated before checking the backlog, so it may be empty.
+                        ::close(m_reserve);
+                        int shed = -1;
+                        do
+                        {
+                            shed = ::accept(m_handle, NULL, NULL);
+                        } while (shed < 0 && isAcceptRetryable(errno));
+
+                        if (shed >= 0)
+                        {
+                            ::close(shed);
+                            status = AcceptStatus::OutOfDescriptors;
+                        }
+                        else if (errno == EAGAIN || errno == EWOULDBLOCK)
+                        {
+                            status = AcceptStatus::WouldBlock;
+                        }
+                        m_reserve = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+                    }
+                    return nullptr;
+                }
+            #else
+                do
+                {
+                    connection = ::accept(m_handle, NULL, NULL);
+                } while (WeppIsSocketInvalid(connection) && ::WSAGetLastError() == WSAECONNRESET);
+
+                if (WeppIsSocketInvalid(connection))
+                {
+                    if (::WSAGetLastError() == WSAEWOULDBLOCK)
+                    {
+                        status = AcceptStatus::WouldBlock;
+                    }
+                    return nullptr;
+                }
+            #endif
+
+            auto socket = std::make_shared<TcpSocket>(connection);
+            #if !defined(WEPP_PLATFORM_LINUX)
+                socket->setBlocking(false);
+            #endif
+            status = AcceptStatus::Accepted;
+            return socket;
+        }
+
+    }
+
+}
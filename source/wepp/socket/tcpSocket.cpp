@@ -26,6 +26,7 @@
 #include "wepp/socket/tcpSocket.hpp"
 #include "wepp/socket/platform/socketFunctions.hpp"
 #include <iostream>
+#include <algorithm>
 
 namespace Wepp
 {
@@ -33,6 +34,8 @@ namespace Wepp
     namespace Socket
     {
 
+        const size_t TcpSocket::maxSendBuffers;
+
         TcpSocket::TcpSocket()
         {
 
@@ -96,12 +99,46 @@ namespace Wepp
 
         int TcpSocket::send(const char * data, const int length)
         {
-            return ::send(m_handle, data, length , 0);
+            return ::send(m_handle, data, length, WEPP_SEND_FLAGS);
         }
 
         int TcpSocket::send(const std::string & data)
         {
-            return ::send(m_handle, data.c_str(), static_cast<int>(data.size()), 0);
+            return ::send(m_handle, data.c_str(), static_cast<int>(data.size()), WEPP_SEND_FLAGS);
+        }
+
+        int TcpSocket::sendv(const SendBuffer * buffers, const size_t count)
+        {
+            const size_t bufferCount = std::min(count, maxSendBuffers);
+
+        #if defined(WEPP_PLATFORM_WINDOWS)
+            WSABUF wsaBuffers[maxSendBuffers];
+            for (size_t i = 0; i < bufferCount; i++)
+            {
+                wsaBuffers[i].buf = const_cast<CHAR *>(buffers[i].data);
+                wsaBuffers[i].len = static_cast<ULONG>(buffers[i].size);
+            }
+
+            DWORD sent = 0;
+            if (::WSASend(m_handle, wsaBuffers, static_cast<DWORD>(bufferCount), &sent, 0, NULL, NULL) != 0)
+            {
+                return -1;
+            }
+            return static_cast<int>(sent);
+        #elif defined(WEPP_PLATFORM_LINUX)
+            // sendmsg rather than writev, to pass MSG_NOSIGNAL.
+            iovec ioBuffers[maxSendBuffers];
+            for (size_t i = 0; i < bufferCount; i++)
+            {
+                ioBuffers[i].iov_base = const_cast<char *>(buffers[i].data);
+                ioBuffers[i].iov_len = buffers[i].size;
+            }
+
+            msghdr message = {};
+            message.msg_iov = ioBuffers;
+            message.msg_iovlen = bufferCount;
+            return static_cast<int>(::sendmsg(m_handle, &message, WEPP_SEND_FLAGS));
+        #endif
         }
 
     }
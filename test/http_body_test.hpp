@@ -0,0 +1,134 @@
+#include "gtest/gtest.h"
+#include "wepp/http/body.hpp"
+#include <cstdlib>
+
+using namespace Wepp;
+
+TEST(Http_Body, Memory)
+{
+    Http::Body body;
+    EXPECT_EQ(body.size(), size_t(0));
+    EXPECT_EQ(body.spillThreshold(), size_t(0));
+    EXPECT_FALSE(body.spilled());
+
+    body << "Hello" << " world";
+    EXPECT_EQ(std::string(body.data(), body.size()), "Hello world");
+    EXPECT_FALSE(body.spilled());
+
+    body = "Replaced";
+    EXPECT_EQ(std::string(body.data(), body.size()), "Replaced");
+
+    body.clear();
+    EXPECT_EQ(body.size(), size_t(0));
+}
+
+TEST(Http_Body, Move)
+{
+    Http::Body body;
+    body << "Hello";
+    const char * data = body.data();
+
+    Http::Body moved(std::move(body));
+    EXPECT_EQ(moved.data(), data);
+    EXPECT_EQ(std::string(moved.data(), moved.size()), "Hello");
+
+    // Small buffers are kept by clear, large buffers are released.
+    moved.clear();
+    EXPECT_GE(moved.capacity(), size_t(5));
+
+    const std::string large(Http::Body::maxRetainedCapacity + 1, 'x');
+    moved << large;
+    moved.clear();
+    EXPECT_EQ(moved.capacity(), size_t(0));
+
+    // Move assignment releases the buffer of the target.
+    moved << large;
+    moved = Http::Body();
+    EXPECT_EQ(moved.size(), size_t(0));
+    EXPECT_EQ(moved.capacity(), size_t(0));
+
+#if defined(WEPP_PLATFORM_LINUX)
+    Http::Body spilled;
+    spilled.spillThreshold(4);
+    spilled << "0123456789";
+    ASSERT_TRUE(spilled.spilled());
+
+    Http::Body target;
+    target = std::move(spilled);
+    EXPECT_FALSE(spilled.spilled());
+    EXPECT_EQ(spilled.size(), size_t(0));
+    EXPECT_TRUE(target.spilled());
+    EXPECT_EQ(std::string(target.data(), target.size()), "0123456789");
+#endif
+}
+
+TEST(Http_Body, Spill)
+{
+#if defined(WEPP_PLATFORM_LINUX)
+    Http::Body body;
+    body.spillThreshold(16);
+    EXPECT_EQ(body.spillThreshold(), size_t(16));
+
+    body.append("0123456789", 10);
+    EXPECT_FALSE(body.spilled());
+    body.append("0123456789", 10);
+    EXPECT_TRUE(body.spilled());
+    EXPECT_EQ(body.size(), size_t(20));
+    EXPECT_EQ(std::string(body.data(), body.size()), "01234567890123456789");
+
+    // Appending after mapping remaps the file.
+    const std::string large(100000, 'x');
+    body.append(large.c_str(), large.size());
+    ASSERT_EQ(body.size(), size_t(100020));
+    EXPECT_EQ(std::string(body.data(), 20), "01234567890123456789");
+    EXPECT_EQ(std::string(body.data() + 20, large.size()), large);
+
+    // Copies are kept in memory.
+    const Http::Body copy(body);
+    EXPECT_FALSE(copy.spilled());
+    ASSERT_EQ(copy.size(), body.size());
+    EXPECT_EQ(std::string(copy.data(), copy.size()), std::string(body.data(), body.size()));
+
+    body.clear();
+    EXPECT_FALSE(body.spilled());
+    EXPECT_EQ(body.size(), size_t(0));
+    body << "again";
+    EXPECT_FALSE(body.spilled());
+    EXPECT_EQ(std::string(body.data(), body.size()), "again");
+#endif
+}
+
+TEST(Http_Body, SpillFailure)
+{
+#if defined(WEPP_PLATFORM_LINUX)
+    const char * tmpdir = std::getenv("TMPDIR");
+    const std::string previous = tmpdir ? tmpdir : "";
+    ::setenv("TMPDIR", "/nonexistent-wepp-directory", 1);
+
+    // The data is kept in memory and spilling is not retried.
+    Http::Body body;
+    body.spillThreshold(4);
+    body << "0123456789";
+    EXPECT_FALSE(body.spilled());
+    EXPECT_TRUE(body.failed());
+    body << "0123456789";
+    EXPECT_FALSE(body.spilled());
+    EXPECT_EQ(std::string(body.data(), body.size()), "01234567890123456789");
+
+    if (tmpdir)
+    {
+        ::setenv("TMPDIR", previous.c_str(), 1);
+    }
+    else
+    {
+        ::unsetenv("TMPDIR");
+    }
+
+    // Cleared bodies may spill again.
+    body.clear();
+    EXPECT_FALSE(body.failed());
+    body << "0123456789";
+    EXPECT_TRUE(body.spilled());
+    EXPECT_FALSE(body.failed());
+#endif
+}
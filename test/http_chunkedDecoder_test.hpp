@@ -0,0 +1,152 @@
+#include "gtest/gtest.h"
+#include "wepp/http/chunkedDecoder.hpp"
+
+using namespace Wepp;
+
+namespace
+{
+    // Decode data split at given positions, returning the result of the last call.
+    Http::ChunkedDecoder::Result decodeSplit(Http::ChunkedDecoder & decoder, const std::string & data,
+                                             const std::vector<size_t> & splits, std::string & body, size_t & position)
+    {
+        Http::ChunkedDecoder::Result result = Http::ChunkedDecoder::Result::NeedMore;
+        position = 0;
+        size_t available = 0;
+
+        for (size_t split = 0; split <= splits.size(); split++)
+        {
+            available = split < splits.size() ? splits[split] : data.size();
+            while (position < available)
+            {
+                size_t consumed = 0;
+                StringView chunk;
+                result = decoder.execute(data.c_str() + position, available - position, consumed, chunk);
+                position += consumed;
+                if (result == Http::ChunkedDecoder::Result::Data)
+                {
+                    EXPECT_GE(chunk.data(), data.c_str());
+                    EXPECT_LE(chunk.data() + chunk.size(), data.c_str() + available);
+                    body.append(chunk.data(), chunk.size());
+                    continue;
+                }
+                if (result != Http::ChunkedDecoder::Result::NeedMore)
+                {
+                    return result;
+                }
+            }
+        }
+
+        return result;
+    }
+}
+
+TEST(Http_ChunkedDecoder, Decode)
+{
+    const std::string data = "5\r\nhello\r\n1;name=value\r\n \r\n0006\r\nworld!\r\nA\r\n0123456789\r\n0\r\nExpires: never\r\n\r\nGET";
+
+    Http::ChunkedDecoder decoder;
+    std::string body;
+    size_t position = 0;
+    EXPECT_EQ(decodeSplit(decoder, data, {}, body, position), Http::ChunkedDecoder::Result::Complete);
+    EXPECT_EQ(body, "hello world!0123456789");
+    EXPECT_EQ(decoder.bodySize(), uint64_t(22));
+    EXPECT_EQ(position, data.size() - 3);
+
+    // Decoder stays complete until reset.
+    size_t consumed = 1;
+    StringView chunk;
+    EXPECT_EQ(decoder.execute(data.c_str() + position, 3, consumed, chunk), Http::ChunkedDecoder::Result::Complete);
+    EXPECT_EQ(consumed, size_t(0));
+}
+
+TEST(Http_ChunkedDecoder, SplitBoundaries)
+{
+    const std::string data = "5\r\nhello\r\n1;ext\r\n \r\n10\r\n0123456789abcdef\r\n0\r\nTrailer: value\r\n\r\n";
+
+    // Every single split position.
+    for (size_t split = 1; split < data.size(); split++)
+    {
+        Http::ChunkedDecoder decoder;
+        std::string body;
+        size_t position = 0;
+        EXPECT_EQ(decodeSplit(decoder, data, { split }, body, position), Http::ChunkedDecoder::Result::Complete) << split;
+        EXPECT_EQ(body, "hello 0123456789abcdef") << split;
+        EXPECT_EQ(position, data.size());
+    }
+
+    // One byte at a time.
+    {
+        std::vector<size_t> splits;
+        for (size_t i = 1; i < data.size(); i++)
+        {
+            splits.push_back(i);
+        }
+
+        Http::ChunkedDecoder decoder;
+        std::string body;
+        size_t position = 0;
+        EXPECT_EQ(decodeSplit(decoder, data, splits, body, position), Http::ChunkedDecoder::Result::Complete);
+        EXPECT_EQ(body, "hello 0123456789abcdef");
+    }
+}
+
+TEST(Http_ChunkedDecoder, Errors)
+{
+    struct Case
+    {
+        std::string data;
+        Http::Status status;
+    };
+
+    const Case cases[] =
+    {
+        { "\r\n", Http::Status::BadRequest },
+        { "x\r\n", Http::Status::BadRequest },
+        { "5\nhello\r\n", Http::Status::BadRequest },
+        { "5\r\nhello!\r\n", Http::Status::BadRequest },
+        { "5\r\nhello\n", Http::Status::BadRequest },
+        { "1;ext\x01\r\n", Http::Status::BadRequest },
+        { "0\r\nTrailer\x01\r\n\r\n", Http::Status::BadRequest },
+        { "0\r\n\n", Http::Status::BadRequest },
+        { "100000000000000000\r\n", Http::Status::PayloadTooLarge }
+    };
+
+    for (auto & c : cases)
+    {
+        Http::ChunkedDecoder decoder;
+        std::string body;
+        size_t position = 0;
+        EXPECT_EQ(decodeSplit(decoder, c.data, {}, body, position), Http::ChunkedDecoder::Result::Error) << c.data;
+        EXPECT_EQ(decoder.error(), c.status) << c.data;
+    }
+}
+
+TEST(Http_ChunkedDecoder, Limits)
+{
+    {
+        Http::ChunkedDecoder decoder(10);
+        std::string body;
+        size_t position = 0;
+        EXPECT_EQ(decodeSplit(decoder, "5\r\nhello\r\n5\r\nworld\r\n0\r\n\r\n", {}, body, position), Http::ChunkedDecoder::Result::Complete);
+
+        decoder.reset();
+        body.clear();
+        EXPECT_EQ(decodeSplit(decoder, "5\r\nhello\r\n6\r\nworld!\r\n0\r\n\r\n", {}, body, position), Http::ChunkedDecoder::Result::Error);
+        EXPECT_EQ(decoder.error(), Http::Status::PayloadTooLarge);
+        EXPECT_EQ(body, "hello");
+    }
+    {
+        Http::ChunkedDecoder decoder(100, 8);
+        std::string body;
+        size_t position = 0;
+        EXPECT_EQ(decodeSplit(decoder, "1;abcdef\r\nx\r\n0\r\n\r\n", {}, body, position), Http::ChunkedDecoder::Result::Complete);
+
+        decoder.reset();
+        EXPECT_EQ(decodeSplit(decoder, "1;abcdefghi\r\nx\r\n0\r\n\r\n", {}, body, position), Http::ChunkedDecoder::Result::Error);
+        EXPECT_EQ(decoder.error(), Http::Status::BadRequest);
+
+        decoder.reset();
+        EXPECT_EQ(decodeSplit(decoder, "0\r\nabcdefghi\r\n\r\n", {}, body, position), Http::ChunkedDecoder::Result::Error);
+        EXPECT_EQ(decoder.error(), Http::Status::RequestHeaderFieldsTooLarge);
+    }
+}
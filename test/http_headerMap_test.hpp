@@ -0,0 +1,81 @@
+#include "gtest/gtest.h"
+#include "wepp/http/headerMap.hpp"
+
+using namespace Wepp;
+
+TEST(Http_Header, Id)
+{
+    for (size_t i = 0; i < static_cast<size_t>(Http::HeaderId::Unknown); i++)
+    {
+        const Http::HeaderId id = static_cast<Http::HeaderId>(i);
+        const std::string & name = Http::getHeaderAsString(id);
+        EXPECT_FALSE(name.empty());
+        EXPECT_EQ(Http::getHeaderId(name), id) << name;
+    }
+
+    EXPECT_EQ(Http::getHeaderId("Content-Length"), Http::HeaderId::ContentLength);
+    EXPECT_EQ(Http::getHeaderId("HOST"), Http::HeaderId::Host);
+    EXPECT_EQ(Http::getHeaderId("hosts"), Http::HeaderId::Unknown);
+    EXPECT_EQ(Http::getHeaderId(""), Http::HeaderId::Unknown);
+    EXPECT_EQ(Http::getHeaderId("x-custom-header-with-a-very-long-name"), Http::HeaderId::Unknown);
+    EXPECT_EQ(Http::getHeaderAsString(Http::HeaderId::Unknown), "");
+}
+
+TEST(Http_HeaderMap, HeaderMap)
+{
+    Http::HeaderMap headers;
+    EXPECT_TRUE(headers.empty());
+    EXPECT_EQ(headers.find("host"), headers.end());
+    EXPECT_EQ(headers.find(Http::HeaderId::Host), headers.end());
+
+    headers.add("Host", "localhost");
+    headers.add("X-Custom", "1");
+    headers.add("x-custom", "2");
+    headers.add("Accept", "*/*");
+    EXPECT_EQ(headers.size(), size_t(4));
+
+    // Last field of duplicated names is found.
+    EXPECT_EQ(headers.find("X-CUSTOM")->second, "2");
+    EXPECT_EQ(headers.find("host")->second, "localhost");
+    EXPECT_EQ(headers.find("host")->id, Http::HeaderId::Host);
+    EXPECT_EQ(headers.find(Http::HeaderId::Accept)->first, "Accept");
+
+    // Map compatibility.
+    auto result = headers.insert({ "host", "other" });
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(result.first->second, "localhost");
+    result = headers.insert({ "Date", "today" });
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(headers.find(Http::HeaderId::Date)->second, "today");
+
+    headers["accept"] = "text/html";
+    EXPECT_EQ(headers.find(Http::HeaderId::Accept)->second, "text/html");
+    EXPECT_EQ(headers["missing"], "");
+    EXPECT_EQ(headers.size(), size_t(6));
+
+    // Erasing rebuilds the index.
+    EXPECT_EQ(headers.erase("x-custom"), size_t(2));
+    EXPECT_EQ(headers.erase("x-custom"), size_t(0));
+    EXPECT_EQ(headers.size(), size_t(4));
+    EXPECT_EQ(headers.find(Http::HeaderId::Accept)->second, "text/html");
+    EXPECT_EQ(headers.find(Http::HeaderId::Date)->second, "today");
+    EXPECT_EQ(headers.begin()->first, "Host");
+
+    headers.set("Host", "example.com");
+    EXPECT_EQ(headers.find(Http::HeaderId::Host)->second, "example.com");
+    EXPECT_EQ(headers.size(), size_t(4));
+
+    headers.clear();
+    EXPECT_TRUE(headers.empty());
+    EXPECT_EQ(headers.find(Http::HeaderId::Host), headers.end());
+}
+
+TEST(Http_HeaderMap, Views)
+{
+    const std::string data = "Content-Type: text/plain";
+
+    Http::HeaderViewMap headers;
+    headers.add(StringView(data.c_str(), 12), StringView(data.c_str() + 14, 10));
+    EXPECT_EQ(headers.find(Http::HeaderId::ContentType)->second, "text/plain");
+    EXPECT_EQ(headers.find("content-type")->second.data(), data.c_str() + 14);
+}
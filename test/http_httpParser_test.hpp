@@ -0,0 +1,145 @@
+#include "gtest/gtest.h"
+#include "wepp/http/httpParser.hpp"
+
+using namespace Wepp;
+
+namespace
+{
+    Http::HttpParser::Result parseAll(Http::HttpParser & parser, const std::string & data, Http::Request & request, size_t & consumed)
+    {
+        consumed = 0;
+        while (true)
+        {
+            size_t lineConsumed = 0;
+            auto result = parser.execute(data.c_str() + consumed, data.size() - consumed, lineConsumed, request);
+            consumed += lineConsumed;
+            if (result != Http::HttpParser::Result::RequestLine)
+            {
+                return result;
+            }
+        }
+    }
+}
+
+TEST(Http_HttpParser, Request)
+{
+    Http::HttpParser parser;
+    Http::Request request;
+    size_t consumed = 0;
+
+    const std::string data = "get /index.html HTTP/1.1\r\nHost: localhost\r\nX-Value: \t foo bar \t\r\nContent-Length: 5\r\n\r\nhello";
+    EXPECT_EQ(parseAll(parser, data, request, consumed), Http::HttpParser::Result::Complete);
+    EXPECT_EQ(consumed, data.size() - 5);
+    EXPECT_STREQ(request.method().c_str(), "GET");
+    EXPECT_STREQ(request.resource().c_str(), "/index.html");
+    EXPECT_STREQ(request.version().c_str(), "HTTP/1.1");
+    EXPECT_EQ(request.headers().size(), size_t(3));
+    EXPECT_STREQ(request.headers()["host"].c_str(), "localhost");
+    EXPECT_STREQ(request.headers()["x-value"].c_str(), "foo bar");
+    EXPECT_EQ(parser.contentLength(), size_t(5));
+    EXPECT_FALSE(parser.chunked());
+
+    parser.reset();
+    EXPECT_EQ(parseAll(parser, "POST / HTTP/1.1\r\nTransfer-Encoding: Chunked\r\n\r\n", request, consumed), Http::HttpParser::Result::Complete);
+    EXPECT_TRUE(parser.chunked());
+}
+
+TEST(Http_HttpParser, Partial)
+{
+    const std::string data = "POST /upload HTTP/1.1\r\nHost: localhost\r\nContent-Length: 1024\r\nEmpty:\r\n\r\n";
+
+    Http::HttpParser parser;
+    Http::Request request;
+    size_t position = 0;
+    size_t available = 0;
+    bool complete = false;
+
+    // Feed one byte at a time, passing unconsumed bytes again.
+    while (!complete && available < data.size())
+    {
+        available++;
+        size_t consumed = 0;
+        auto result = parser.execute(data.c_str() + position, available - position, consumed, request);
+        position += consumed;
+        ASSERT_NE(result, Http::HttpParser::Result::Error);
+        if (result == Http::HttpParser::Result::RequestLine)
+        {
+            EXPECT_STREQ(request.method().c_str(), "POST");
+            EXPECT_EQ(request.headers().size(), size_t(0));
+        }
+        complete = result == Http::HttpParser::Result::Complete;
+    }
+
+    EXPECT_TRUE(complete);
+    EXPECT_EQ(position, data.size());
+    EXPECT_STREQ(request.resource().c_str(), "/upload");
+    EXPECT_EQ(request.headers().size(), size_t(3));
+    EXPECT_STREQ(request.headers()["empty"].c_str(), "");
+    EXPECT_EQ(parser.contentLength(), size_t(1024));
+
+    parser.reset();
+    EXPECT_EQ(parser.contentLength(), size_t(0));
+}
+
+TEST(Http_HttpParser, Errors)
+{
+    struct Case
+    {
+        std::string data;
+        Http::Status status;
+    };
+
+    const Case cases[] =
+    {
+        { "GET /index.html HTTP/1.0\r\n\r\n", Http::Status::HttpVersionNotSupported },
+        { "GET  /index.html HTTP/1.1\r\n\r\n", Http::Status::BadRequest },
+        { "G(T /index.html HTTP/1.1\r\n\r\n", Http::Status::BadRequest },
+        { "GET /index.html HTTP/1.1\n\r\n", Http::Status::BadRequest },
+        { "GET / HTTP/1.1\r\nHost : localhost\r\n\r\n", Http::Status::BadRequest },
+        { "GET / HTTP/1.1\r\n Host: localhost\r\n\r\n", Http::Status::BadRequest },
+        { "GET / HTTP/1.1\r\nHost: local\x01host\r\n\r\n", Http::Status::BadRequest },
+        { "GET / HTTP/1.1\r\nContent-Length: 12a\r\n\r\n", Http::Status::BadRequest },
+        { "GET / HTTP/1.1\r\nContent-Length: 99999999999999999999999\r\n\r\n", Http::Status::BadRequest },
+        { "GET / HTTP/1.1\r\nContent-Length: 1\r\nContent-Length: 2\r\n\r\n", Http::Status::BadRequest },
+        { "GET / HTTP/1.1\r\nTransfer-Encoding: gzip, chunked\r\n\r\n", Http::Status::NotImplemented },
+        { "GET / HTTP/1.1\r\nTransfer-Encoding: chunked\r\nTransfer-Encoding: chunked\r\n\r\n", Http::Status::BadRequest },
+        { "GET / HTTP/1.1\r\nTransfer-Encoding: chunked\r\nContent-Length: 5\r\n\r\n", Http::Status::BadRequest }
+    };
+
+    for (auto & c : cases)
+    {
+        Http::HttpParser parser;
+        Http::Request request;
+        size_t consumed = 0;
+        EXPECT_EQ(parseAll(parser, c.data, request, consumed), Http::HttpParser::Result::Error) << c.data;
+        EXPECT_EQ(parser.error(), c.status) << c.data;
+    }
+}
+
+TEST(Http_HttpParser, Limits)
+{
+    {
+        Http::HttpParser parser(16, 16, 2);
+        Http::Request request;
+        size_t consumed = 0;
+        EXPECT_EQ(parseAll(parser, "GET /0123456789abcdef", request, consumed), Http::HttpParser::Result::Error);
+        EXPECT_EQ(parser.error(), Http::Status::UriTooLong);
+        EXPECT_EQ(consumed, size_t(0));
+    }
+    {
+        Http::HttpParser parser(16, 16, 2);
+        Http::Request request;
+        size_t consumed = 0;
+        EXPECT_EQ(parseAll(parser, "GET / HTTP/1.1\r\nX-Value: 0123456789abcdef", request, consumed), Http::HttpParser::Result::Error);
+        EXPECT_EQ(parser.error(), Http::Status::RequestHeaderFieldsTooLarge);
+    }
+    {
+        Http::HttpParser parser(16, 16, 2);
+        Http::Request request;
+        size_t consumed = 0;
+        EXPECT_EQ(parseAll(parser, "GET / HTTP/1.1\r\nA: 1\r\nB: 2\r\n\r\n", request, consumed), Http::HttpParser::Result::Complete);
+        parser.reset();
+        EXPECT_EQ(parseAll(parser, "GET / HTTP/1.1\r\nA: 1\r\nB: 2\r\nC: 3\r\n\r\n", request, consumed), Http::HttpParser::Result::Error);
+        EXPECT_EQ(parser.error(), Http::Status::BadRequest);
+    }
+}
@@ -14,4 +14,25 @@ TEST(Http_Method, Name)
     EXPECT_STREQ(Http::getMethodAsString(Http::Method::Option).c_str(), "OPTION");
     EXPECT_STREQ(Http::getMethodAsString(Http::Method::Connect).c_str(), "CONNECT");
     EXPECT_STREQ(Http::getMethodAsString(Http::Method::Patch).c_str(), "PATCH");
-}
\ No newline at end of file
+}
+TEST(Http_Method, Parse)
+{
+    Http::Method method = Http::Method::Get;
+    EXPECT_TRUE(Http::parseMethod("POST", method));
+    EXPECT_EQ(method, Http::Method::Post);
+    EXPECT_TRUE(Http::parseMethod("PATCH", method));
+    EXPECT_EQ(method, Http::Method::Patch);
+    EXPECT_FALSE(Http::parseMethod("post", method));
+    EXPECT_FALSE(Http::parseMethod("GETS", method));
+    EXPECT_FALSE(Http::parseMethod("", method));
+    EXPECT_FALSE(Http::parseMethod("G", method));
+    EXPECT_FALSE(Http::parseMethod("PURGE", method));
+    EXPECT_EQ(method, Http::Method::Patch);
+
+    for (size_t i = 0; i < static_cast<size_t>(Http::Method::Custom); i++)
+    {
+        const Http::Method expected = static_cast<Http::Method>(i);
+        EXPECT_TRUE(Http::parseMethod(Http::getMethodAsString(expected), method));
+        EXPECT_EQ(method, expected);
+    }
+}
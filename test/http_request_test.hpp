@@ -57,4 +57,69 @@ TEST(Request, Request)
             EXPECT_EQ(const_req.headers().size(), size_t(3));
         }
     }
-}
\ No newline at end of file
+}
+TEST(Request, Views)
+{
+    std::string data = "get /index.html HTTP/1.1Host:localhostConnection:close";
+
+    Http::Request request;
+    request.methodView(Wepp::StringView(data.c_str(), 3));
+    request.resourceView(Wepp::StringView(data.c_str() + 4, 11));
+    request.versionView(Wepp::StringView(data.c_str() + 16, 8));
+    request.addHeaderView(Wepp::StringView(data.c_str() + 24, 4), Wepp::StringView(data.c_str() + 29, 9));
+    request.addHeaderView(Wepp::StringView(data.c_str() + 38, 10), Wepp::StringView(data.c_str() + 49, 5));
+
+    // Views refer to the data.
+    EXPECT_EQ(request.methodView(), "get");
+    EXPECT_EQ(request.methodView().data(), data.c_str());
+    EXPECT_EQ(request.resourceView(), "/index.html");
+    EXPECT_EQ(request.versionView(), "HTTP/1.1");
+    EXPECT_EQ(request.header("host"), "localhost");
+    EXPECT_EQ(request.header("CONNECTION"), "close");
+    EXPECT_EQ(request.header("connection").data(), data.c_str() + 49);
+    EXPECT_TRUE(request.hasHeader("Host"));
+    EXPECT_FALSE(request.hasHeader("Hos"));
+    EXPECT_TRUE(request.header("content-length").empty());
+
+    // Owned copies are made on demand.
+    EXPECT_EQ(request.method(), "GET");
+    EXPECT_EQ(request.methodView(), "GET");
+    EXPECT_EQ(request.resourceView().data(), data.c_str() + 4);
+
+    request.materialize();
+    data.assign(data.size(), 'x');
+
+    EXPECT_EQ(request.resource(), "/index.html");
+    EXPECT_EQ(request.resourceView(), "/index.html");
+    EXPECT_EQ(request.version(), "HTTP/1.1");
+    EXPECT_EQ(request.headers().size(), size_t(2));
+    EXPECT_EQ(request.headers()["host"], "localhost");
+    EXPECT_EQ(request.headers()["connection"], "close");
+    EXPECT_EQ(request.header("Connection"), "close");
+
+    request.method("post");
+    EXPECT_EQ(request.methodView(), "POST");
+}
+
+TEST(Request, Reset)
+{
+    const std::string resource = "/" + std::string(64, 'r');
+    Http::Request request;
+    request.method("POST").resource(resource).version("HTTP/1.0");
+    request.headers().add("Content-Type", std::string(64, 'v'));
+    request.addHeaderView("Host", "localhost");
+    request.body() << "body";
+    const char * resourceData = request.resource().data();
+
+    request.reset();
+    EXPECT_EQ(request.method(), "");
+    EXPECT_EQ(request.resource(), "");
+    EXPECT_EQ(request.version(), "HTTP/1.1");
+    EXPECT_TRUE(request.headers().empty());
+    EXPECT_FALSE(request.hasHeader("Host"));
+    EXPECT_EQ(request.body().size(), size_t(0));
+
+    // Memory of strings is kept on reuse.
+    request.resource("/index.html");
+    EXPECT_EQ(request.resource().data(), resourceData);
+}
@@ -15,4 +15,62 @@ TEST(Response, Response)
         response.status(Http::Status::Conflict).status(Http::Status::Accepted);
         EXPECT_EQ(response.status(), Http::Status::Accepted);
     }
-}
\ No newline at end of file
+}
+
+TEST(Response, Headers)
+{
+    Http::Response response;
+    EXPECT_EQ(response.headers().size(), size_t(0));
+
+    response.header("Content-Type", "text/html").header("Set-Cookie", "a=1");
+    response.headers().add("Set-Cookie", "b=2");
+    EXPECT_EQ(response.headers().size(), size_t(3));
+
+    response.header("content-type", "text/plain");
+    EXPECT_EQ(response.headers().size(), size_t(3));
+    EXPECT_EQ(response.headers().find(Http::HeaderId::ContentType)->second, "text/plain");
+    EXPECT_EQ(response.headers().find(Http::HeaderId::SetCookie)->second, "b=2");
+
+    const Http::Response & constResponse = response;
+    EXPECT_EQ(constResponse.headers().find("SET-COOKIE")->second, "b=2");
+}
+
+TEST(Response, Reset)
+{
+    Http::Response response;
+    response.header(Http::HeaderId::ContentType, "text/html").header(Http::HeaderId::Unknown, "ignored");
+    EXPECT_EQ(response.headers().size(), size_t(1));
+    EXPECT_EQ(response.headers().find("Content-Type")->second, "text/html");
+
+    response.header(Http::HeaderId::ContentType, "text/plain");
+    EXPECT_EQ(response.headers().size(), size_t(1));
+    EXPECT_EQ(response.headers().find(Http::HeaderId::ContentType)->second, "text/plain");
+
+    response.status(Http::Status::NotFound) << "Not found";
+    response.reset();
+    EXPECT_EQ(response.status(), Http::Status::Ok);
+    EXPECT_EQ(response.headers().size(), size_t(0));
+    EXPECT_EQ(response.headers().find(Http::HeaderId::ContentType), response.headers().end());
+    EXPECT_EQ(response.body().size(), size_t(0));
+}
+
+TEST(Response, ResetCapacity)
+{
+    const std::string value(64, 'v');
+    Http::Response response;
+    response.header(Http::HeaderId::ContentType, value) << std::string(1024, 'b');
+    const char * valueData = response.headers().find(Http::HeaderId::ContentType)->second.data();
+    const size_t bodyCapacity = response.body().capacity();
+
+    // Memory of header values and body is kept on reuse.
+    response.reset();
+    response.header(Http::HeaderId::ContentType, "text/plain") << "small";
+    EXPECT_EQ(response.headers().find(Http::HeaderId::ContentType)->second.data(), valueData);
+    EXPECT_EQ(response.body().capacity(), bodyCapacity);
+
+    // Memory of large bodies is released.
+    response << std::string(Http::Body::maxRetainedCapacity, 'b');
+    response.reset();
+    EXPECT_EQ(response.body().capacity(), size_t(0));
+    EXPECT_EQ(response.headers().find(Http::HeaderId::ContentType), response.headers().end());
+}
@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 #include "wepp/http/router.hpp"
+#include <thread>
 
 using namespace Wepp;
 
@@ -195,4 +196,385 @@ TEST(Http_RouteMethod, Path)
         EXPECT_STREQ(matches[1].c_str(),"cool");
     }
    
-}
\ No newline at end of file
+}
+TEST(Http_RouteMethod, Stream)
+{
+    Http::Router router;
+    router["POST"]["/upload/<>"].stream(
+        [](const Http::Request &, Http::Response &, const StringView &) { return true; },
+        [](const Http::Request &, Http::Response &) {});
+    router["POST"]["/buffered"] = [](const Http::Request &, Http::Response &) {};
+
+    std::vector<std::string> matches;
+    const Http::RouteCallback * route = router.findRoute("POST", "/upload/file", matches);
+    ASSERT_NE(route, nullptr);
+    EXPECT_NE(route->callback, nullptr);
+    EXPECT_NE(route->dataCallback, nullptr);
+    ASSERT_EQ(matches.size(), size_t(1));
+    EXPECT_EQ(matches[0], "file");
+
+    route = router.findRoute("POST", "/buffered", matches);
+    ASSERT_NE(route, nullptr);
+    EXPECT_NE(route->callback, nullptr);
+    EXPECT_EQ(route->dataCallback, nullptr);
+
+    EXPECT_EQ(router.findRoute("POST", "/missing", matches), nullptr);
+    EXPECT_EQ(router.findRoute("GET", "/buffered", matches), nullptr);
+}
+TEST(Http_RouteMethod, Trie)
+{
+    Http::Router router;
+    auto & get = router[Http::Method::Get];
+    get["/"] = [](const Http::Request &, Http::Response &) {};
+    get["/x/y/z/w"] = [](const Http::Request &, Http::Response &) {};
+    get["/dir/"] = [](const Http::Request &, Http::Response &) {};
+    get["/user/<>"] = [](const Http::Request &, Http::Response &) {};
+    get["/user/me"] = [](const Http::Request &, Http::Response &) {};
+    for (int i = 0; i < 2000; i++)
+    {
+        get["/r" + std::to_string(i) + "/<>/item"] = [](const Http::Request &, Http::Response &) {};
+    }
+
+    std::vector<std::string> matches;
+    EXPECT_NE(get.findRoute("/", matches), nullptr);
+    EXPECT_NE(get.findRoute("/x/y/z/w", matches), nullptr);
+    EXPECT_EQ(get.findRoute("/x/y", matches), nullptr);
+    EXPECT_EQ(get.findRoute("/x/y/z/w/", matches), nullptr);
+    EXPECT_EQ(get.findRoute("/x/y/z/wq", matches), nullptr);
+    EXPECT_EQ(get.findRoute("/x/y/q/w", matches), nullptr);
+    EXPECT_NE(get.findRoute("/dir/", matches), nullptr);
+    EXPECT_EQ(get.findRoute("/dir", matches), nullptr);
+
+    EXPECT_NE(get.findRoute("/user/me", matches), nullptr);
+    EXPECT_EQ(matches.size(), size_t(0));
+    EXPECT_NE(get.findRoute("/user/you", matches), nullptr);
+    ASSERT_EQ(matches.size(), size_t(1));
+    EXPECT_EQ(matches[0], "you");
+
+    for (int i = 0; i < 2000; i++)
+    {
+        const std::string index = std::to_string(i);
+        ASSERT_NE(get.findRoute("/r" + index + "/" + index + "/item", matches), nullptr);
+        ASSERT_EQ(matches.size(), size_t(1));
+        EXPECT_EQ(matches[0], index);
+    }
+    EXPECT_EQ(get.findRoute("/r2000/1/item", matches), nullptr);
+    EXPECT_EQ(matches.size(), size_t(0));
+
+    // Registering after lookup recompiles the trie.
+    get["/x/y"] = [](const Http::Request &, Http::Response &) {};
+    EXPECT_NE(get.findRoute("/x/y", matches), nullptr);
+    EXPECT_NE(get.findRoute("/x/y/z/w", matches), nullptr);
+}
+TEST(Http_RouteMethod, TypedParameters)
+{
+    Http::Router router;
+    auto & get = router[Http::Method::Get];
+    get["/item/<id:int>"] = [](const Http::Request &, Http::Response &) {};
+    get["/item/<slug>"] = [](const Http::Request &, Http::Response &) {};
+    get["/user/<uuid>/name"] = [](const Http::Request &, Http::Response &) {};
+    get["/files/<file:path*>"] = [](const Http::Request &, Http::Response &) {};
+    get["/page_<n:int>.html"] = [](const Http::Request &, Http::Response &) {};
+    get["/any/<name:str>"] = [](const Http::Request &, Http::Response &) {};
+
+    std::vector<Http::RouteParameter> parameters;
+    ASSERT_NE(router.findRoute("GET", "/item/-42", parameters), nullptr);
+    ASSERT_EQ(parameters.size(), size_t(1));
+    EXPECT_EQ(parameters[0].name, "id");
+    EXPECT_EQ(parameters[0].type, Http::RouteParameter::Type::Int);
+    EXPECT_EQ(parameters[0].value, "-42");
+    EXPECT_EQ(parameters[0].integer, int64_t(-42));
+
+    ASSERT_NE(get.findRoute("/item/9223372036854775807", parameters), nullptr);
+    ASSERT_EQ(parameters.size(), size_t(1));
+    EXPECT_EQ(parameters[0].integer, int64_t(9223372036854775807));
+    ASSERT_NE(get.findRoute("/item/-9223372036854775808", parameters), nullptr);
+    ASSERT_EQ(parameters.size(), size_t(1));
+    EXPECT_EQ(parameters[0].integer, std::numeric_limits<int64_t>::min());
+
+    // Not integers, falling back to slug.
+    ASSERT_NE(get.findRoute("/item/9223372036854775808", parameters), nullptr);
+    ASSERT_EQ(parameters.size(), size_t(1));
+    EXPECT_EQ(parameters[0].type, Http::RouteParameter::Type::Slug);
+    ASSERT_NE(get.findRoute("/item/my-item_1", parameters), nullptr);
+    ASSERT_EQ(parameters.size(), size_t(1));
+    EXPECT_EQ(parameters[0].type, Http::RouteParameter::Type::Slug);
+    EXPECT_EQ(parameters[0].value, "my-item_1");
+    EXPECT_EQ(get.findRoute("/item/my.item", parameters), nullptr);
+    EXPECT_EQ(get.findRoute("/item/", parameters), nullptr);
+
+    ASSERT_NE(get.findRoute("/user/123e4567-e89b-12d3-A456-426614174000/name", parameters), nullptr);
+    ASSERT_EQ(parameters.size(), size_t(1));
+    EXPECT_EQ(parameters[0].type, Http::RouteParameter::Type::Uuid);
+    EXPECT_EQ(parameters[0].value, "123e4567-e89b-12d3-A456-426614174000");
+    EXPECT_EQ(get.findRoute("/user/123e4567-e89b-12d3-a456-42661417400/name", parameters), nullptr);
+    EXPECT_EQ(get.findRoute("/user/123e4567+e89b-12d3-a456-426614174000/name", parameters), nullptr);
+    EXPECT_EQ(get.findRoute("/user/123e4567-e89b-12d3-a456-42661417400g/name", parameters), nullptr);
+
+    ASSERT_NE(get.findRoute("/files/a/b/c.txt", parameters), nullptr);
+    ASSERT_EQ(parameters.size(), size_t(1));
+    EXPECT_EQ(parameters[0].name, "file");
+    EXPECT_EQ(parameters[0].value, "a/b/c.txt");
+
+    ASSERT_NE(get.findRoute("/page_12.html", parameters), nullptr);
+    ASSERT_EQ(parameters.size(), size_t(1));
+    EXPECT_EQ(parameters[0].name, "n");
+    EXPECT_EQ(parameters[0].integer, int64_t(12));
+    EXPECT_EQ(get.findRoute("/page_x.html", parameters), nullptr);
+    EXPECT_EQ(get.findRoute("/page_99999999999999999999.html", parameters), nullptr);
+
+    ASSERT_NE(get.findRoute("/any/some.thing", parameters), nullptr);
+    ASSERT_EQ(parameters.size(), size_t(1));
+    EXPECT_EQ(parameters[0].name, "name");
+    EXPECT_EQ(parameters[0].type, Http::RouteParameter::Type::String);
+
+    // Typed parameters are captured as text by the string overload.
+    std::vector<std::string> matches;
+    ASSERT_NE(get.findRoute("/item/42", matches), nullptr);
+    ASSERT_EQ(matches.size(), size_t(1));
+    EXPECT_EQ(matches[0], "42");
+}
+TEST(Http_RouteMethod, Captures)
+{
+    Http::Router router;
+    router["GET"]["/shop/<shop:slug>/item/<id:int>/<>"] = [](const Http::Request &, Http::Response &, const Http::RouteCaptures &) {};
+
+    const std::string path = "/shop/my-shop/item/42/extra";
+    Http::RouteCaptures captures;
+    const Http::RouteCallback * route = router.findRoute("GET", StringView(path), captures);
+    ASSERT_NE(route, nullptr);
+    EXPECT_TRUE(route->routed());
+    EXPECT_EQ(route->callback, nullptr);
+    EXPECT_NE(route->captureCallback, nullptr);
+
+    ASSERT_EQ(captures.size(), size_t(3));
+    EXPECT_EQ(captures[0], StringView("my-shop"));
+    EXPECT_EQ(captures[0].data(), path.data() + 6);
+    EXPECT_EQ(captures.name(1), StringView("id"));
+    EXPECT_EQ(captures.type(1), Http::RouteParameter::Type::Int);
+    EXPECT_EQ(captures.integer(1), int64_t(42));
+    EXPECT_TRUE(captures.name(2).empty());
+    EXPECT_EQ(captures[2], StringView("extra"));
+
+    EXPECT_EQ(captures.find("shop"), size_t(0));
+    EXPECT_EQ(captures.find("missing"), Http::RouteCaptures::npos);
+    EXPECT_EQ(captures.value("shop"), StringView("my-shop"));
+    EXPECT_TRUE(captures.value("missing").empty());
+    EXPECT_EQ(captures.integer("id"), int64_t(42));
+    EXPECT_EQ(captures.integer("missing", -1), int64_t(-1));
+
+    // Captures follow a copy of the path.
+    const std::string copy = path;
+    captures.rebase(copy.data());
+    EXPECT_EQ(captures[0].data(), copy.data() + 6);
+    EXPECT_EQ(captures.value("shop"), StringView("my-shop"));
+
+    EXPECT_EQ(router.findRoute("GET", StringView("/shop/my-shop/item/x/extra"), captures), nullptr);
+    EXPECT_TRUE(captures.empty());
+
+    // Captures beyond the capacity are dropped.
+    std::string manyRoute;
+    std::string manyPath;
+    for (size_t i = 0; i < Http::RouteCaptures::capacity + 2; i++)
+    {
+        manyRoute += "/<>";
+        manyPath += "/" + std::to_string(i);
+    }
+    router["GET"][manyRoute] = [](const Http::Request &, Http::Response &) {};
+    ASSERT_NE(router.findRoute("GET", StringView(manyPath), captures), nullptr);
+    EXPECT_EQ(captures.size(), Http::RouteCaptures::capacity);
+}
+TEST(Http_Router, Snapshot)
+{
+    Http::Router router;
+    Http::RouteCaptures captures;
+    int called = 0;
+
+    // Nothing is published yet.
+    EXPECT_EQ(router.snapshot()->findRoute("GET", "/a", captures), nullptr);
+
+    router["GET"]["/a"] = [&called](const Http::Request &, Http::Response &) { called = 1; };
+    EXPECT_EQ(router.snapshot()->findRoute("GET", "/a", captures), nullptr);
+    router.publish();
+    auto first = router.snapshot();
+    ASSERT_NE(first->findRoute("GET", "/a", captures), nullptr);
+
+    // Changes are not visible to earlier snapshots.
+    router["GET"]["/a"] = [&called](const Http::Request &, Http::Response &) { called = 2; };
+    router["GET"]["/b/<id:int>"] = [&called](const Http::Request &, Http::Response &) { called = 3; };
+    router["POST"]["/c"] = [&called](const Http::Request &, Http::Response &) { called = 4; };
+    router.publish();
+    auto second = router.snapshot();
+
+    Http::Request request;
+    Http::Response response;
+    const Http::RouteCallback * route = first->findRoute("GET", "/a", captures);
+    ASSERT_NE(route, nullptr);
+    route->callback(request, response);
+    EXPECT_EQ(called, 1);
+    EXPECT_EQ(first->findRoute("GET", "/b/1", captures), nullptr);
+    EXPECT_EQ(first->findRoute("POST", "/c", captures), nullptr);
+
+    route = second->findRoute("GET", "/a", captures);
+    ASSERT_NE(route, nullptr);
+    route->callback(request, response);
+    EXPECT_EQ(called, 2);
+    ASSERT_NE(second->findRoute("GET", "/b/1", captures), nullptr);
+    EXPECT_EQ(captures.integer("id"), int64_t(1));
+    EXPECT_NE(second->findRoute("POST", "/c", captures), nullptr);
+
+    // Reassigned callbacks are found by direct lookups, without publishing.
+    router["GET"]["/a"] = [&called](const Http::Request &, Http::Response &) { called = 5; };
+    std::vector<std::string> matches;
+    route = router.findRoute("GET", "/a", matches);
+    ASSERT_NE(route, nullptr);
+    route->callback(request, response);
+    EXPECT_EQ(called, 5);
+}
+TEST(Http_Router, SnapshotCache)
+{
+    Http::Router router1;
+    Http::Router router2;
+    Http::RouteCaptures captures;
+    router1["GET"]["/a"] = [](const Http::Request &, Http::Response &) {};
+    router2["GET"]["/b"] = [](const Http::Request &, Http::Response &) {};
+    router1.publish();
+    router2.publish();
+
+    // Snapshots are remembered per thread, until another router is read or a new version is published.
+    auto first = router1.snapshot();
+    EXPECT_EQ(router1.snapshot(), first);
+    EXPECT_NE(first->findRoute("GET", "/a", captures), nullptr);
+
+    EXPECT_NE(router2.snapshot()->findRoute("GET", "/b", captures), nullptr);
+    EXPECT_EQ(router2.snapshot()->findRoute("GET", "/a", captures), nullptr);
+    EXPECT_EQ(router1.snapshot(), first);
+
+    router1["GET"]["/c"] = [](const Http::Request &, Http::Response &) {};
+    EXPECT_EQ(router1.snapshot(), first);
+    router1.publish();
+    EXPECT_NE(router1.snapshot(), first);
+    EXPECT_NE(router1.snapshot()->findRoute("GET", "/c", captures), nullptr);
+    EXPECT_EQ(first->findRoute("GET", "/c", captures), nullptr);
+
+    // Snapshots are owned by their readers, replaced snapshots are released by the last of them.
+    std::weak_ptr<const Http::Router::Snapshot> released = first;
+    first.reset();
+    EXPECT_TRUE(released.expired());
+
+    // Other threads see the published snapshot.
+    std::shared_ptr<const Http::Router::Snapshot> other;
+    std::thread thread([&router1, &other]()
+    {
+        other = router1.snapshot();
+    });
+    thread.join();
+    EXPECT_EQ(other, router1.snapshot());
+}
+TEST(Http_Router, Cache)
+{
+    Http::Router router;
+    EXPECT_EQ(router.cacheCapacity(), size_t(0));
+    router["GET"]["/user/<id:int>/<>"] = [](const Http::Request &, Http::Response &, const Http::RouteCaptures &) {};
+    router["GET"]["/static"] = [](const Http::Request &, Http::Response &) {};
+
+    Http::RouteCaptures captures;
+    EXPECT_NE(router.findRoute("GET", StringView("/static"), captures), nullptr);
+    Http::Router::CacheStatistics statistics = router.cacheStatistics();
+    EXPECT_EQ(statistics.hits + statistics.misses, uint64_t(0));
+
+    router.cacheCapacity(32);
+    EXPECT_EQ(router.cacheCapacity(), size_t(32));
+    const std::string path = "/user/42/name";
+    for (int i = 0; i < 3; i++)
+    {
+        // Copy path, cached captures must refer to the path of each lookup.
+        const std::string pathCopy = path;
+        ASSERT_NE(router.findRoute("GET", StringView(pathCopy), captures), nullptr);
+        ASSERT_EQ(captures.size(), size_t(2));
+        EXPECT_EQ(captures[0].data(), pathCopy.data() + 6);
+        EXPECT_EQ(captures.integer("id"), int64_t(42));
+        EXPECT_EQ(captures[1], StringView("name"));
+    }
+    statistics = router.cacheStatistics();
+    EXPECT_EQ(statistics.misses, uint64_t(1));
+    EXPECT_EQ(statistics.hits, uint64_t(2));
+    EXPECT_EQ(statistics.size, size_t(1));
+
+    // Other lookups are served by the cache too.
+    std::vector<std::string> matches;
+    ASSERT_NE(router.findRoute("GET", path, matches), nullptr);
+    ASSERT_EQ(matches.size(), size_t(2));
+    EXPECT_EQ(matches[0], "42");
+    std::vector<Http::RouteParameter> parameters;
+    ASSERT_NE(router.findRoute("GET", path, parameters), nullptr);
+    ASSERT_EQ(parameters.size(), size_t(2));
+    EXPECT_EQ(parameters[0].name, "id");
+    EXPECT_EQ(parameters[0].integer, int64_t(42));
+    EXPECT_EQ(router.cacheStatistics().hits, uint64_t(4));
+
+    // Not found paths are not cached.
+    EXPECT_EQ(router.findRoute("GET", StringView("/user/x/name"), captures), nullptr);
+    EXPECT_EQ(router.findRoute("GET", StringView("/user/x/name"), captures), nullptr);
+    EXPECT_TRUE(captures.empty());
+    EXPECT_EQ(router.cacheStatistics().size, size_t(1));
+
+    // Size is bounded.
+    for (int i = 0; i < 1000; i++)
+    {
+        ASSERT_NE(router.findRoute("GET", StringView("/user/" + std::to_string(i) + "/x"), captures), nullptr);
+        EXPECT_EQ(captures.integer("id"), int64_t(i));
+    }
+    statistics = router.cacheStatistics();
+    EXPECT_LE(statistics.size, size_t(32));
+    EXPECT_GT(statistics.evictions, uint64_t(0));
+
+    // Small capacities are exact.
+    for (const size_t capacity : { size_t(1), size_t(3), size_t(20) })
+    {
+        router.cacheCapacity(capacity);
+        for (int i = 0; i < 1000; i++)
+        {
+            ASSERT_NE(router.findRoute("GET", StringView("/user/" + std::to_string(i) + "/x"), captures), nullptr);
+        }
+        EXPECT_LE(router.cacheStatistics().size, capacity);
+    }
+
+    // Changing routes clears the cache.
+    router["GET"]["/user/<id:int>/<>"] = [](const Http::Request &, Http::Response &) {};
+    statistics = router.cacheStatistics();
+    EXPECT_EQ(statistics.size, size_t(0));
+    EXPECT_EQ(statistics.hits + statistics.misses, uint64_t(0));
+    const Http::RouteCallback * route = router.findRoute("GET", StringView(path), captures);
+    ASSERT_NE(route, nullptr);
+    EXPECT_NE(route->callback, nullptr);
+}
+TEST(Http_Router, MethodDispatch)
+{
+    Http::Router router;
+    Http::RouteCaptures captures;
+    std::vector<std::string> matches;
+    EXPECT_THROW(router[Http::Method::Custom], std::invalid_argument);
+
+    router[Http::Method::Get]["/a"] = [](const Http::Request &, Http::Response &) {};
+    router["purge"]["/a"] = [](const Http::Request &, Http::Response &) {};
+    EXPECT_EQ(router.methodCount(), size_t(2));
+    EXPECT_EQ(&router["get"], &router[Http::Method::Get]);
+    EXPECT_EQ(&router["PURGE"], &router["Purge"]);
+
+    EXPECT_NE(router.findRoute("GET", "/a", matches), nullptr);
+    EXPECT_NE(router.findRoute("get", "/a", matches), nullptr);
+    EXPECT_NE(router.findRoute("PURGE", "/a", matches), nullptr);
+    EXPECT_NE(router.findRoute("purge", "/a", matches), nullptr);
+    EXPECT_EQ(router.findRoute("POST", "/a", matches), nullptr);
+    EXPECT_EQ(router.findRoute("FUBAR", "/a", matches), nullptr);
+
+    router.publish();
+    auto snapshot = router.snapshot();
+    EXPECT_NE(snapshot->findRoute(Http::Method::Get, "/a", captures), nullptr);
+    EXPECT_EQ(snapshot->findRoute(Http::Method::Post, "/a", captures), nullptr);
+    EXPECT_EQ(snapshot->findRoute(Http::Method::Custom, "/a", captures), nullptr);
+    EXPECT_NE(snapshot->findRoute("get", "/a", captures), nullptr);
+    EXPECT_NE(snapshot->findRoute("Purge", "/a", captures), nullptr);
+    EXPECT_EQ(snapshot->findRoute("FUBAR", "/a", captures), nullptr);
+}
@@ -0,0 +1,730 @@
+#include "gtest/gtest.h"
+#include "wepp/http/server.hpp"
+#include "wepp/http/staticRouter.hpp"
+#include <thread>
+#include <atomic>
+#include <cstdlib>
+
+using namespace Wepp;
+
+namespace
+{
+    std::string receiveUntilClosed(Socket::TcpSocket & socket)
+    {
+        std::string result;
+        char buffer[1024];
+        int size = 0;
+        while ((size = socket.receive(buffer, sizeof(buffer))) > 0)
+        {
+            result.append(buffer, static_cast<size_t>(size));
+        }
+        return result;
+    }
+
+    std::string receiveResponse(Socket::TcpSocket & socket, std::string & pending)
+    {
+        std::string result;
+        std::swap(result, pending);
+        char buffer[1024];
+        int size = 0;
+        size_t headerEnd = std::string::npos;
+        while ((headerEnd = result.find("\r\n\r\n")) == std::string::npos &&
+               (size = socket.receive(buffer, sizeof(buffer))) > 0)
+        {
+            result.append(buffer, static_cast<size_t>(size));
+        }
+        if (headerEnd == std::string::npos)
+        {
+            return result;
+        }
+
+        const size_t lengthPosition = result.find("Content-Length: ");
+        const size_t contentLength = lengthPosition == std::string::npos ? 0 : std::stoul(result.substr(lengthPosition + 16));
+        while (result.size() < headerEnd + 4 + contentLength &&
+               (size = socket.receive(buffer, sizeof(buffer))) > 0)
+        {
+            result.append(buffer, static_cast<size_t>(size));
+        }
+
+        // Keep bytes of any following response.
+        if (result.size() > headerEnd + 4 + contentLength)
+        {
+            pending = result.substr(headerEnd + 4 + contentLength);
+            result.resize(headerEnd + 4 + contentLength);
+        }
+        return result;
+    }
+
+    std::string receiveResponse(Socket::TcpSocket & socket)
+    {
+        std::string pending;
+        return receiveResponse(socket, pending);
+    }
+}
+
+TEST(Http_ServerConnection, Request)
+{
+    const unsigned short port = 54346;
+
+    {
+        Http::Server server;
+        server.route["GET"]["/hello"] = [](const Http::Request &, Http::Response & response)
+        {
+            response << "Hello world";
+        };
+        server.route["POST"]["/echo"] = [](const Http::Request & request, Http::Response & response)
+        {
+            response << std::string(request.body().data(), request.body().size());
+        };
+        server.route["GET"]["/headers"] = [](const Http::Request & request, Http::Response & response)
+        {
+            response.header("Content-Type", "text/plain").header("X-Agent", request.header(Http::HeaderId::UserAgent).str());
+            response.header("Content-Length", "1000");
+            response.header(Http::HeaderId::Date, "Sun, 06 Nov 1994 08:49:37 GMT");
+        };
+        server.route["GET"]["/inject"] = [](const Http::Request &, Http::Response & response)
+        {
+            response.header("X-Value", "foo\r\nX-Injected: value\r\n\r\nbody\x7f\tbar");
+            response.header("X-Name\r\nX-Injected", "value");
+            response.header("X-Name: value\r\nX-Injected", "value");
+            response.header("", "value");
+            response << "Hello";
+        };
+        ASSERT_TRUE(server.start(port).wait(std::chrono::seconds(3)).successful());
+
+        {
+            Socket::TcpSocket client;
+            ASSERT_TRUE(client.connect("127.0.0.1", port));
+            client.send("GET /hello HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n");
+            const std::string response = receiveUntilClosed(client);
+            EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n"), size_t(0));
+            EXPECT_NE(response.find("Content-Length: 11\r\n"), std::string::npos);
+            EXPECT_NE(response.find("\r\n\r\nHello world"), std::string::npos);
+            const size_t date = response.find("\r\nDate: ");
+            ASSERT_NE(date, std::string::npos);
+            EXPECT_EQ(response.substr(date + 33, 6), " GMT\r\n");
+        }
+        {
+            // Request split into several packets.
+            Socket::TcpSocket client;
+            ASSERT_TRUE(client.connect("127.0.0.1", port));
+            client.send("POST /echo HT");
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            client.send("TP/1.1\r\nContent-Length: 7\r\nConnection: Close\r\n");
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            client.send("\r\nfoo");
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            client.send(" bar");
+            const std::string response = receiveUntilClosed(client);
+            EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n"), size_t(0));
+            EXPECT_NE(response.find("\r\n\r\nfoo bar"), std::string::npos);
+        }
+        {
+            // Chunked request body, split into several packets.
+            Socket::TcpSocket client;
+            ASSERT_TRUE(client.connect("127.0.0.1", port));
+            client.send("POST /echo HTTP/1.1\r\nTransfer-Encoding: chunked\r\nConnection: close\r\n\r\n4\r\nfoo ");
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            client.send("\r\n3\r\nb");
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            client.send("ar\r\n0\r\n\r\n");
+            const std::string response = receiveUntilClosed(client);
+            EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n"), size_t(0));
+            EXPECT_NE(response.find("Content-Length: 7\r\n"), std::string::npos);
+            EXPECT_NE(response.find("\r\n\r\nfoo bar"), std::string::npos);
+        }
+        {
+            Socket::TcpSocket client;
+            ASSERT_TRUE(client.connect("127.0.0.1", port));
+            client.send("GET /headers HTTP/1.1\r\nUser-Agent: test\r\nConnection: close\r\n\r\n");
+            const std::string response = receiveUntilClosed(client);
+            EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n"), size_t(0));
+            EXPECT_NE(response.find("\r\nContent-Type: text/plain\r\n"), std::string::npos);
+            EXPECT_NE(response.find("\r\nX-Agent: test\r\n"), std::string::npos);
+            EXPECT_NE(response.find("\r\nContent-Length: 0\r\n"), std::string::npos);
+            EXPECT_EQ(response.find("Content-Length: 1000"), std::string::npos);
+            EXPECT_NE(response.find("\r\ndate: Sun, 06 Nov 1994 08:49:37 GMT\r\n"), std::string::npos);
+            EXPECT_EQ(response.find("\r\nDate: "), std::string::npos);
+        }
+        {
+            // Control bytes of handler-supplied fields are not sent.
+            Socket::TcpSocket client;
+            ASSERT_TRUE(client.connect("127.0.0.1", port));
+            client.send("GET /inject HTTP/1.1\r\nConnection: close\r\n\r\n");
+            const std::string response = receiveUntilClosed(client);
+            EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n"), size_t(0));
+            EXPECT_NE(response.find("\r\nX-Value: fooX-Injected: valuebody\tbar\r\n"), std::string::npos);
+            EXPECT_EQ(response.find("\r\nX-Injected"), std::string::npos);
+            EXPECT_EQ(response.find("X-Name"), std::string::npos);
+            EXPECT_EQ(response.find("\r\n: "), std::string::npos);
+            EXPECT_EQ(response.find("\r\n\r\n"), response.size() - 9);
+        }
+        {
+            Socket::TcpSocket client;
+            ASSERT_TRUE(client.connect("127.0.0.1", port));
+            client.send("GET /missing HTTP/1.1\r\n\r\n");
+            // Failed requests close the connection.
+            const std::string response = receiveUntilClosed(client);
+            EXPECT_EQ(response.find("HTTP/1.1 404 Not Found\r\n"), size_t(0));
+        }
+    }
+}
+
+TEST(Http_ServerConnection, LargeBody)
+{
+    const unsigned short port = 54346;
+
+    {
+        std::string body(1024 * 1024, ' ');
+        for (size_t i = 0; i < body.size(); i++)
+        {
+            body[i] = static_cast<char>('a' + i % 26);
+        }
+
+        Http::Server server;
+        server.route["GET"]["/large"] = [&body](const Http::Request &, Http::Response & response)
+        {
+            response << body;
+        };
+        server.route["GET"]["/small"] = [](const Http::Request &, Http::Response & response)
+        {
+            response << "small";
+        };
+        ASSERT_TRUE(server.start(port).wait(std::chrono::seconds(3)).successful());
+
+        // The large body is gathered with the buffered response of the first request.
+        Socket::TcpSocket client;
+        ASSERT_TRUE(client.connect("127.0.0.1", port));
+        client.send("GET /small HTTP/1.1\r\n\r\nGET /large HTTP/1.1\r\n\r\nGET /small HTTP/1.1\r\nConnection: close\r\n\r\n");
+
+        const std::string response = receiveUntilClosed(client);
+        const size_t large = response.find("Content-Length: 1048576\r\n");
+        ASSERT_NE(large, std::string::npos);
+        EXPECT_EQ(response.find("\r\n\r\nsmall"), response.find("\r\n\r\n"));
+        const size_t bodyStart = response.find("\r\n\r\n", large) + 4;
+        EXPECT_EQ(response.compare(bodyStart, body.size(), body), 0);
+        EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n", bodyStart + body.size()), bodyStart + body.size());
+        EXPECT_EQ(response.substr(response.size() - 9), "\r\n\r\nsmall");
+    }
+}
+
+TEST(Http_ServerConnection, IdleConnections)
+{
+    const unsigned short port = 54346;
+
+    {
+        Http::Server server;
+        server.route["GET"]["/hello"] = [](const Http::Request &, Http::Response & response)
+        {
+            response << "Hello world";
+        };
+        ASSERT_TRUE(server.start(port).wait(std::chrono::seconds(3)).successful());
+
+        // More idle connections than workers in the receive pool.
+        std::vector<std::unique_ptr<Socket::TcpSocket>> idleClients;
+        for (size_t i = 0; i < 50; i++)
+        {
+            idleClients.push_back(std::unique_ptr<Socket::TcpSocket>(new Socket::TcpSocket));
+            ASSERT_TRUE(idleClients.back()->connect("127.0.0.1", port));
+            idleClients.back()->send("GET /hello HTTP/1.1\r\n");
+        }
+
+        Socket::TcpSocket client;
+        ASSERT_TRUE(client.connect("127.0.0.1", port));
+        client.send("GET /hello HTTP/1.1\r\n\r\n");
+        const std::string response = receiveResponse(client);
+        EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n"), size_t(0));
+
+        EXPECT_TRUE(server.stop().wait(std::chrono::seconds(3)).successful());
+    }
+}
+
+TEST(Http_ServerConnection, KeepAlive)
+{
+    const unsigned short port = 54346;
+
+    {
+        Http::Server::Settings settings;
+        settings.keepAliveMaxRequests = 3;
+        settings.keepAliveTimeout = std::chrono::milliseconds(300);
+
+        Http::Server server(settings);
+        server.route["GET"]["/hello"] = [](const Http::Request &, Http::Response & response)
+        {
+            response << "Hello world";
+        };
+        server.route["GET"]["/typed"] = [](const Http::Request &, Http::Response & response)
+        {
+            response.header(Http::HeaderId::ContentType, "text/plain").header(Http::HeaderId::CacheControl, "no-cache");
+            response << "Typed";
+        };
+        ASSERT_TRUE(server.start(port).wait(std::chrono::seconds(3)).successful());
+
+        {
+            Socket::TcpSocket client;
+            ASSERT_TRUE(client.connect("127.0.0.1", port));
+
+            // Responses are reused by the connection, fields of a previous response must not be sent again.
+            client.send("GET /typed HTTP/1.1\r\nConnection: keep-alive\r\n\r\n");
+            const std::string typed = receiveResponse(client);
+            EXPECT_NE(typed.find("\r\ncontent-type: text/plain\r\ncache-control: no-cache\r\n"), std::string::npos);
+            EXPECT_NE(typed.find("\r\n\r\nTyped"), std::string::npos);
+
+            client.send("GET /hello HTTP/1.1\r\nConnection: keep-alive\r\n\r\n");
+            const std::string response = receiveResponse(client);
+            EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n"), size_t(0));
+            EXPECT_EQ(response.find("content-type"), std::string::npos);
+            EXPECT_NE(response.find("\r\n\r\nHello world"), std::string::npos);
+
+            // Request limit reached.
+            client.send("GET /hello HTTP/1.1\r\n\r\n");
+            const std::string last = receiveUntilClosed(client);
+            EXPECT_EQ(last.find("HTTP/1.1 200 OK\r\n"), size_t(0));
+            EXPECT_NE(last.find("Connection: close\r\n"), std::string::npos);
+        }
+        {
+            Socket::TcpSocket client;
+            ASSERT_TRUE(client.connect("127.0.0.1", port));
+
+            for (size_t i = 0; i < 2; i++)
+            {
+                client.send("GET /hello HTTP/1.1\r\nConnection: keep-alive\r\n\r\n");
+                const std::string response = receiveResponse(client);
+                EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n"), size_t(0));
+                EXPECT_NE(response.find("Connection: keep-alive\r\n"), std::string::npos);
+                EXPECT_NE(response.find("\r\n\r\nHello world"), std::string::npos);
+            }
+
+            // Request limit reached.
+            client.send("GET /hello HTTP/1.1\r\n\r\n");
+            const std::string response = receiveUntilClosed(client);
+            EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n"), size_t(0));
+            EXPECT_NE(response.find("Connection: close\r\n"), std::string::npos);
+        }
+        {
+            // Idle timeout.
+            Socket::TcpSocket client;
+            ASSERT_TRUE(client.connect("127.0.0.1", port));
+            client.send("GET /hello HTTP/1.1\r\n\r\n");
+            EXPECT_NE(receiveResponse(client).find("Connection: keep-alive\r\n"), std::string::npos);
+
+            auto start = std::chrono::steady_clock::now();
+            EXPECT_EQ(receiveUntilClosed(client), "");
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            EXPECT_GE(elapsed.count(), 0.2);
+            EXPECT_LT(elapsed.count(), 3.0);
+        }
+    }
+}
+
+TEST(Http_ServerConnection, ParkedConnections)
+{
+    const unsigned short port = 54346;
+
+    {
+        Http::Server server;
+        server.route["GET"]["/hello"] = [](const Http::Request &, Http::Response & response)
+        {
+            response << "Hello world";
+        };
+        ASSERT_TRUE(server.start(port).wait(std::chrono::seconds(3)).successful());
+
+        // More open keep-alive connections than workers in the receive pool.
+        std::vector<std::unique_ptr<Socket::TcpSocket>> clients;
+        for (size_t i = 0; i < 30; i++)
+        {
+            clients.push_back(std::unique_ptr<Socket::TcpSocket>(new Socket::TcpSocket));
+            ASSERT_TRUE(clients.back()->connect("127.0.0.1", port));
+        }
+
+        for (size_t i = 0; i < 2; i++)
+        {
+            for (auto & client : clients)
+            {
+                client->send("GET /hello HTTP/1.1\r\n\r\n");
+                const std::string response = receiveResponse(*client);
+                EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n"), size_t(0));
+                EXPECT_NE(response.find("Connection: keep-alive\r\n"), std::string::npos);
+            }
+        }
+    }
+}
+
+TEST(Http_ServerConnection, Pipelining)
+{
+    const unsigned short port = 54346;
+
+    {
+        Http::Server server;
+        server.route["GET"]["/<>"] = [](const Http::Request & request, Http::Response & response)
+        {
+            response << request.resource();
+        };
+        server.route["POST"]["/<>"] = [](const Http::Request & request, Http::Response & response)
+        {
+            response << std::string(request.body().data(), request.body().size());
+        };
+        ASSERT_TRUE(server.start(port).wait(std::chrono::seconds(3)).successful());
+
+        Socket::TcpSocket client;
+        ASSERT_TRUE(client.connect("127.0.0.1", port));
+        client.send("GET /first HTTP/1.1\r\n\r\n"
+                    "POST /second HTTP/1.1\r\nContent-Length: 6\r\n\r\nsecond"
+                    "GET /third HTTP/1.1\r\n\r\n"
+                    "GET /fourth HT");
+
+        std::string pending;
+        EXPECT_NE(receiveResponse(client, pending).find("\r\n\r\n/first"), std::string::npos);
+        EXPECT_NE(receiveResponse(client, pending).find("\r\n\r\nsecond"), std::string::npos);
+        EXPECT_NE(receiveResponse(client, pending).find("\r\n\r\n/third"), std::string::npos);
+        EXPECT_EQ(pending, "");
+
+        // Remaining bytes of the partial request are kept.
+        client.send("TP/1.1\r\nConnection: close\r\n\r\n");
+        const std::string response = receiveUntilClosed(client);
+        EXPECT_NE(response.find("Connection: close\r\n"), std::string::npos);
+        EXPECT_NE(response.find("\r\n\r\n/fourth"), std::string::npos);
+    }
+}
+
+TEST(Http_ServerConnection, StreamingBody)
+{
+    const unsigned short port = 54346;
+    const size_t uploadSize = 4 * 1024 * 1024;
+
+    {
+        std::atomic<size_t> received(0);
+        std::atomic<size_t> maxSlice(0);
+
+        Http::Server server;
+        server.route["POST"]["/upload"].stream(
+            [&received, &maxSlice](const Http::Request &, Http::Response &, const StringView & data) -> bool
+            {
+                received += data.size();
+                maxSlice = std::max<size_t>(maxSlice, data.size());
+                return true;
+            },
+            [&received](const Http::Request & request, Http::Response & response)
+            {
+                // The body is never buffered.
+                response << std::to_string(request.body().size()) << " " << std::to_string(received);
+            });
+        server.route["POST"]["/reject"].stream(
+            [](const Http::Request &, Http::Response & response, const StringView &) -> bool
+            {
+                response.status(Http::Status::PayloadTooLarge);
+                return false;
+            },
+            [](const Http::Request &, Http::Response &)
+            {
+                ADD_FAILURE() << "End callback of aborted request is called.";
+            });
+        ASSERT_TRUE(server.start(port).wait(std::chrono::seconds(3)).successful());
+
+        {
+            Socket::TcpSocket client;
+            ASSERT_TRUE(client.connect("127.0.0.1", port));
+            client.send("POST /upload HTTP/1.1\r\nContent-Length: " + std::to_string(uploadSize) + "\r\nConnection: close\r\n\r\n");
+
+            const std::string block(65536, 'x');
+            for (size_t sent = 0; sent < uploadSize; sent += block.size())
+            {
+                ASSERT_EQ(client.send(block), static_cast<int>(block.size()));
+            }
+
+            const std::string response = receiveUntilClosed(client);
+            EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n"), size_t(0));
+            EXPECT_NE(response.find("\r\n\r\n0 " + std::to_string(uploadSize)), std::string::npos);
+
+            // Slices never exceed the connection buffer.
+            EXPECT_GT(maxSlice.load(), size_t(0));
+            EXPECT_LE(maxSlice.load(), size_t(16384));
+        }
+        {
+            Socket::TcpSocket client;
+            ASSERT_TRUE(client.connect("127.0.0.1", port));
+            client.send("POST /reject HTTP/1.1\r\nContent-Length: 10\r\n\r\n0123456789");
+            const std::string response = receiveUntilClosed(client);
+            EXPECT_EQ(response.find("HTTP/1.1 413 Payload Too Large\r\n"), size_t(0));
+        }
+    }
+}
+
+TEST(Http_ServerConnection, BodyLimits)
+{
+    const unsigned short port = 54347;
+
+    {
+        Http::Server::Settings settings;
+        settings.bodyMemoryLimit = 1024;
+        settings.bodySizeLimit = 8192;
+
+        Http::Server server(settings);
+        server.route["POST"]["/body"] = [](const Http::Request & request, Http::Response & response)
+        {
+            const auto & body = request.body();
+            response << (body.spilled() ? "spilled " : "memory ") << std::string(body.data(), body.size());
+        };
+        ASSERT_TRUE(server.start(port).wait(std::chrono::seconds(3)).successful());
+
+        {
+            Socket::TcpSocket client;
+            ASSERT_TRUE(client.connect("127.0.0.1", port));
+
+            client.send("POST /body HTTP/1.1\r\nContent-Length: 5\r\n\r\nsmall");
+            std::string response = receiveResponse(client);
+            EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n"), size_t(0));
+            EXPECT_NE(response.find("\r\n\r\nmemory small"), std::string::npos);
+
+            const std::string body(4096, 'b');
+            client.send("POST /body HTTP/1.1\r\nContent-Length: 4096\r\n\r\n" + body);
+            response = receiveResponse(client);
+            EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n"), size_t(0));
+            EXPECT_NE(response.find("\r\n\r\nspilled " + body), std::string::npos);
+        }
+#if defined(WEPP_PLATFORM_LINUX)
+        {
+            // The body can not be spilled, the connection is closed.
+            const char * tmpdir = std::getenv("TMPDIR");
+            const std::string previous = tmpdir ? tmpdir : "";
+            ::setenv("TMPDIR", "/nonexistent-wepp-directory", 1);
+
+            Socket::TcpSocket client;
+            ASSERT_TRUE(client.connect("127.0.0.1", port));
+            client.send("POST /body HTTP/1.1\r\nContent-Length: 4096\r\n\r\n" + std::string(4096, 'b'));
+            const std::string response = receiveUntilClosed(client);
+            EXPECT_EQ(response.find("HTTP/1.1 507 Insufficient Storage\r\n"), size_t(0));
+
+            if (tmpdir)
+            {
+                ::setenv("TMPDIR", previous.c_str(), 1);
+            }
+            else
+            {
+                ::unsetenv("TMPDIR");
+            }
+        }
+#endif
+        {
+            // Rejected before the body is sent.
+            Socket::TcpSocket client;
+            ASSERT_TRUE(client.connect("127.0.0.1", port));
+            client.send("POST /body HTTP/1.1\r\nContent-Length: 1048576\r\n\r\n");
+            const std::string response = receiveUntilClosed(client);
+            EXPECT_EQ(response.find("HTTP/1.1 413 Payload Too Large\r\n"), size_t(0));
+        }
+        {
+            Socket::TcpSocket client;
+            ASSERT_TRUE(client.connect("127.0.0.1", port));
+            client.send("POST /body HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n"
+                        "1000\r\n" + std::string(4096, 'c') + "\r\n"
+                        "1001\r\n" + std::string(4097, 'c') + "\r\n0\r\n\r\n");
+            const std::string response = receiveUntilClosed(client);
+            EXPECT_EQ(response.find("HTTP/1.1 413 Payload Too Large\r\n"), size_t(0));
+        }
+    }
+}
+
+TEST(Http_ServerConnection, ExpectContinue)
+{
+    const unsigned short port = 54348;
+    static const std::string s_continue = "HTTP/1.1 100 Continue\r\n\r\n";
+
+    {
+        Http::Server::Settings settings;
+        settings.bodySizeLimit = 1024;
+
+        Http::Server server(settings);
+        server.route["POST"]["/echo"] = [](const Http::Request & request, Http::Response & response)
+        {
+            response << std::string(request.body().data(), request.body().size());
+        };
+        ASSERT_TRUE(server.start(port).wait(std::chrono::seconds(3)).successful());
+
+        {
+            Socket::TcpSocket client;
+            ASSERT_TRUE(client.connect("127.0.0.1", port));
+            client.send("POST /echo HTTP/1.1\r\nContent-Length: 5\r\nExpect: 100-continue\r\n\r\n");
+
+            char buffer[64];
+            std::string interim;
+            int size = 0;
+            while (interim.size() < s_continue.size() &&
+                   (size = client.receive(buffer, static_cast<int>(s_continue.size() - interim.size()))) > 0)
+            {
+                interim.append(buffer, static_cast<size_t>(size));
+            }
+            EXPECT_EQ(interim, s_continue);
+
+            client.send("hello");
+            const std::string response = receiveResponse(client);
+            EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n"), size_t(0));
+            EXPECT_NE(response.find("\r\n\r\nhello"), std::string::npos);
+        }
+        {
+            // Rejected requests are answered without waiting for the body.
+            Socket::TcpSocket client;
+            ASSERT_TRUE(client.connect("127.0.0.1", port));
+            client.send("POST /missing HTTP/1.1\r\nContent-Length: 5\r\nExpect: 100-continue\r\n\r\n");
+            const std::string response = receiveUntilClosed(client);
+            EXPECT_EQ(response.find("HTTP/1.1 404 Not Found\r\n"), size_t(0));
+        }
+        {
+            Socket::TcpSocket client;
+            ASSERT_TRUE(client.connect("127.0.0.1", port));
+            client.send("POST /echo HTTP/1.1\r\nContent-Length: 1025\r\nExpect: 100-continue\r\n\r\n");
+            const std::string response = receiveUntilClosed(client);
+            EXPECT_EQ(response.find("HTTP/1.1 413 Payload Too Large\r\n"), size_t(0));
+        }
+        {
+            Socket::TcpSocket client;
+            ASSERT_TRUE(client.connect("127.0.0.1", port));
+            client.send("POST /echo HTTP/1.1\r\nContent-Length: 5\r\nExpect: something\r\n\r\n");
+            const std::string response = receiveUntilClosed(client);
+            EXPECT_EQ(response.find("HTTP/1.1 417 Expectation Failed\r\n"), size_t(0));
+        }
+    }
+}
+
+TEST(Http_ServerConnection, RouteCaptures)
+{
+    const unsigned short port = 54346;
+
+    Http::Server server;
+    server.route["POST"]["/user/<name:slug>/post/<id:int>"] =
+        [](const Http::Request & request, Http::Response & response, const Http::RouteCaptures & captures)
+        {
+            response << captures.value("name").str() << " " << std::to_string(captures.integer("id") + 1) << " " << std::to_string(request.body().size());
+        };
+    ASSERT_TRUE(server.start(port).wait(std::chrono::seconds(3)).successful());
+
+    Socket::TcpSocket client;
+    ASSERT_TRUE(client.connect("127.0.0.1", port));
+    client.send("POST /user/jane-doe/post/41 HTTP/1.1\r\nContent-Length: 3\r\n\r\nabc");
+    std::string response = receiveResponse(client);
+    EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n"), size_t(0));
+    EXPECT_NE(response.find("\r\n\r\njane-doe 42 3"), std::string::npos);
+
+    // The body arrives later, after the request head has left the receive buffer.
+    client.send("POST /user/john/post/-2 HTTP/1.1\r\nContent-Length: 4\r\n\r\n");
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    client.send("abcd");
+    response = receiveResponse(client);
+    EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n"), size_t(0));
+    EXPECT_NE(response.find("\r\n\r\njohn -1 4"), std::string::npos);
+
+    client.send("POST /user/john/post/x HTTP/1.1\r\nContent-Length: 0\r\n\r\n");
+    response = receiveResponse(client);
+    EXPECT_EQ(response.find("HTTP/1.1 404 Not Found\r\n"), size_t(0));
+}
+
+TEST(Http_ServerConnection, StaticRouter)
+{
+    const unsigned short port = 54346;
+
+    auto router = Http::makeStaticRouter(
+        Http::staticRoute(Http::Method::Get, "/item/<id:int>", [](const Http::Request &, Http::Response & response, const Http::RouteCaptures & captures)
+        {
+            response << std::to_string(captures.integer("id") * 2);
+        }));
+
+    Http::Server server;
+    server.route["GET"]["/item/<>"] = [](const Http::Request &, Http::Response &)
+    {
+        ADD_FAILURE() << "Dynamic router is used.";
+    };
+    server.routeFinder(std::cref(router));
+    ASSERT_TRUE(server.start(port).wait(std::chrono::seconds(3)).successful());
+
+    Socket::TcpSocket client;
+    ASSERT_TRUE(client.connect("127.0.0.1", port));
+    client.send("GET /item/21 HTTP/1.1\r\n\r\n");
+    std::string response = receiveResponse(client);
+    EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n"), size_t(0));
+    EXPECT_NE(response.find("\r\n\r\n42"), std::string::npos);
+
+    client.send("GET /item/x HTTP/1.1\r\n\r\n");
+    response = receiveResponse(client);
+    EXPECT_EQ(response.find("HTTP/1.1 404 Not Found\r\n"), size_t(0));
+}
+
+TEST(Http_ServerConnection, StaticRouterDirect)
+{
+    const unsigned short port = 54346;
+
+    auto router = Http::makeStaticRouter(
+        Http::staticRoute(Http::Method::Post, "/item/<id:int>", [](const Http::Request &, Http::Response &)
+        {
+            ADD_FAILURE() << "Route of other method is used.";
+        }),
+        Http::staticRoute(Http::Method::Get, "/item/<id:int>", [](const Http::Request &, Http::Response & response, const Http::RouteCaptures & captures)
+        {
+            response << std::to_string(captures.integer("id") * 2);
+        }),
+        Http::staticRoute(Http::Method::Get, "/hello", [](const Http::Request &, Http::Response & response)
+        {
+            response << "Hello";
+        }));
+
+    // Handlers are called directly by the router.
+    Http::Server server;
+    server.routeFinder(router);
+    ASSERT_TRUE(server.start(port).wait(std::chrono::seconds(3)).successful());
+
+    Socket::TcpSocket client;
+    ASSERT_TRUE(client.connect("127.0.0.1", port));
+    client.send("GET /item/21 HTTP/1.1\r\n\r\nGET /hello HTTP/1.1\r\n\r\n");
+    std::string pending;
+    std::string response = receiveResponse(client, pending);
+    EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n"), size_t(0));
+    EXPECT_NE(response.find("\r\n\r\n42"), std::string::npos);
+    response = receiveResponse(client, pending);
+    EXPECT_NE(response.find("\r\n\r\nHello"), std::string::npos);
+
+    client.send("GET /item/x HTTP/1.1\r\n\r\n");
+    response = receiveResponse(client, pending);
+    EXPECT_EQ(response.find("HTTP/1.1 404 Not Found\r\n"), size_t(0));
+}
+
+TEST(Http_ServerConnection, PublishRoutes)
+{
+    const unsigned short port = 54346;
+
+    Http::Router other;
+    Http::Server server;
+    server.route["GET"]["/v"] = [](const Http::Request &, Http::Response & response) { response << "0"; };
+    ASSERT_TRUE(server.start(port).wait(std::chrono::seconds(3)).successful());
+
+    // Publish new routes while requests are served. Handlers reading other routes keep their own routes alive.
+    std::atomic_bool publishing(true);
+    std::thread publisher([&server, &other, &publishing]()
+    {
+        for (int i = 1; publishing; i++)
+        {
+            const std::string value = std::to_string(i);
+            server.route["GET"]["/v"] = [value, &other](const Http::Request &, Http::Response & response)
+            {
+                other.snapshot();
+                response << value;
+            };
+            server.route["GET"]["/r" + std::to_string(i % 50)] = [](const Http::Request &, Http::Response &) {};
+            server.route.publish();
+        }
+    });
+
+    Socket::TcpSocket client;
+    ASSERT_TRUE(client.connect("127.0.0.1", port));
+    for (int i = 0; i < 200; i++)
+    {
+        client.send("GET /v HTTP/1.1\r\n\r\n");
+        const std::string response = receiveResponse(client);
+        EXPECT_EQ(response.find("HTTP/1.1 200 OK\r\n"), size_t(0));
+    }
+    publishing = false;
+    publisher.join();
+
+    client.send("GET /r1 HTTP/1.1\r\n\r\n");
+    EXPECT_EQ(receiveResponse(client).find("HTTP/1.1 200 OK\r\n"), size_t(0));
+    client.send("GET /missing HTTP/1.1\r\n\r\n");
+    EXPECT_EQ(receiveResponse(client).find("HTTP/1.1 404 Not Found\r\n"), size_t(0));
+}
@@ -0,0 +1,123 @@
+#include "gtest/gtest.h"
+#include "wepp/http/staticRouter.hpp"
+
+using namespace Wepp;
+
+TEST(Http_StaticRouter, Find)
+{
+    int called = 0;
+    auto router = Http::makeStaticRouter(
+        Http::staticRoute(Http::Method::Get, "/", [&called](const Http::Request &, Http::Response &) { called = 1; }),
+        Http::staticRoute(Http::Method::Get, "/user/me", [&called](const Http::Request &, Http::Response &) { called = 2; }),
+        Http::staticRoute(Http::Method::Get, "/user/<id:int>", [&called](const Http::Request &, Http::Response &, const Http::RouteCaptures & captures)
+        {
+            called = static_cast<int>(captures.integer("id"));
+        }),
+        Http::staticRoute(Http::Method::Post, "/user/<name:slug>/page_<n:int>.html", [](const Http::Request &, Http::Response &) {}),
+        Http::staticRoute(Http::Method::Get, "/files/<file:path*>", [](const Http::Request &, Http::Response &) {}),
+        Http::staticRoute(Http::Method::Get, "/any/<>/end", [](const Http::Request &, Http::Response &) {}));
+    EXPECT_EQ(router.size(), size_t(6));
+
+    Http::Request request;
+    Http::Response response;
+    Http::RouteCaptures captures;
+
+    const Http::RouteCallback * route = router.findRoute("GET", "/", captures);
+    ASSERT_NE(route, nullptr);
+    ASSERT_NE(route->callback, nullptr);
+    route->callback(request, response);
+    EXPECT_EQ(called, 1);
+
+    // Routes are tried in declaration order.
+    route = router.findRoute("GET", "/user/me", captures);
+    ASSERT_NE(route, nullptr);
+    route->callback(request, response);
+    EXPECT_EQ(called, 2);
+    EXPECT_TRUE(captures.empty());
+
+    route = router.findRoute("GET", "/user/123", captures);
+    ASSERT_NE(route, nullptr);
+    ASSERT_NE(route->captureCallback, nullptr);
+    route->captureCallback(request, response, captures);
+    EXPECT_EQ(called, 123);
+
+    EXPECT_EQ(router.findRoute("GET", "/user/abc", captures), nullptr);
+    EXPECT_TRUE(captures.empty());
+    EXPECT_EQ(router.findRoute("PUT", "/user/123", captures), nullptr);
+    EXPECT_EQ(router.findRoute("NOPE", "/user/123", captures), nullptr);
+    EXPECT_EQ(router.findRoute("GET", "/user/123/", captures), nullptr);
+    EXPECT_EQ(router.findRoute("GET", "/user", captures), nullptr);
+
+    ASSERT_NE(router.findRoute("POST", "/user/jane-doe/page_7.html", captures), nullptr);
+    ASSERT_EQ(captures.size(), size_t(2));
+    EXPECT_EQ(captures.value("name"), StringView("jane-doe"));
+    EXPECT_EQ(captures.integer("n"), int64_t(7));
+    EXPECT_EQ(router.findRoute("POST", "/user/jane-doe/page_7.htm", captures), nullptr);
+    EXPECT_EQ(router.findRoute("POST", "/user/jane-doe/page_.html", captures), nullptr);
+
+    ASSERT_NE(router.findRoute("GET", "/files/a/b.txt", captures), nullptr);
+    ASSERT_EQ(captures.size(), size_t(1));
+    EXPECT_EQ(captures.value("file"), StringView("a/b.txt"));
+
+    ASSERT_NE(router.findRoute("GET", "/any/some.thing/end", captures), nullptr);
+    ASSERT_EQ(captures.size(), size_t(1));
+    EXPECT_EQ(captures[0], StringView("some.thing"));
+
+    // Callbacks follow the handlers when moved.
+    auto moved = std::move(router);
+    route = moved.findRoute("GET", "/user/me", captures);
+    ASSERT_NE(route, nullptr);
+    called = 0;
+    route->callback(request, response);
+    EXPECT_EQ(called, 2);
+}
+
+TEST(Http_StaticRouter, Call)
+{
+    int called = 0;
+    auto router = Http::makeStaticRouter(
+        Http::staticRoute(Http::Method::Post, "/item/<id:int>", [&called](const Http::Request &, Http::Response &) { called = -1; }),
+        Http::staticRoute(Http::Method::Get, "/item/<id:int>", [&called](const Http::Request &, Http::Response &, const Http::RouteCaptures & captures)
+        {
+            called = static_cast<int>(captures.integer("id"));
+        }),
+        Http::staticRoute(Http::Method::Get, "/item/<id:int>", [&called](const Http::Request &, Http::Response &) { called = -2; }),
+        Http::staticRoute(Http::Method::Put, "/item", [&called](const Http::Request &, Http::Response &) { called = 1; }),
+        Http::staticRoute(Http::Method::Custom, "/item", [](const Http::Request &, Http::Response &) {}));
+
+    Http::Request request;
+    Http::Response response;
+    Http::RouteCaptures captures;
+
+    // Routes of the method are tried in declaration order, and handlers are called directly.
+    const Http::RouteCallback * route = router.findRoute(Http::Method::Get, "/item/5", captures);
+    ASSERT_NE(route, nullptr);
+    router.call(route, request, response, captures);
+    EXPECT_EQ(called, 5);
+
+    route = router.findRoute(Http::Method::Post, "/item/5", captures);
+    ASSERT_NE(route, nullptr);
+    router.call(route, request, response, captures);
+    EXPECT_EQ(called, -1);
+
+    route = router.findRoute(Http::Method::Put, "/item", captures);
+    ASSERT_NE(route, nullptr);
+    router.call(route, request, response, captures);
+    EXPECT_EQ(called, 1);
+
+    EXPECT_EQ(router.findRoute(Http::Method::Put, "/item/5", captures), nullptr);
+    EXPECT_EQ(router.findRoute(Http::Method::Delete, "/item", captures), nullptr);
+    EXPECT_EQ(router.findRoute(Http::Method::Custom, "/item", captures), nullptr);
+}
+
+TEST(Http_StaticRouter, InvalidPattern)
+{
+    auto handler = [](const Http::Request &, Http::Response &) {};
+
+    // Unsupported patterns are rejected at construction.
+    EXPECT_THROW(Http::makeStaticRouter(Http::staticRoute(Http::Method::Get, "/regex/<([a-z]+)>", handler)), std::invalid_argument);
+    EXPECT_THROW(Http::makeStaticRouter(Http::staticRoute(Http::Method::Get, "/item", handler),
+                                        Http::staticRoute(Http::Method::Get, "/double/<a:int><b:int>", handler)), std::invalid_argument);
+    EXPECT_THROW(Http::makeStaticRouter(Http::staticRoute(Http::Method::Get, "/open/<id:int", handler)), std::invalid_argument);
+    EXPECT_NO_THROW(Http::makeStaticRouter(Http::staticRoute(Http::Method::Get, "/item/<id:int>", handler)));
+}
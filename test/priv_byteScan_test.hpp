@@ -0,0 +1,62 @@
+#include "gtest/gtest.h"
+#include "wepp/priv/byteScan.hpp"
+#include <string>
+
+using namespace Wepp;
+
+TEST(Priv_ByteScan, FindByte)
+{
+    EXPECT_NE(std::string(Priv::byteScanInstructionSet()), "");
+
+    // Cover scalar tails and every position of 16 and 32 byte blocks.
+    for (size_t size = 0; size < 100; size++)
+    {
+        for (size_t position = 0; position <= size; position++)
+        {
+            std::string data(size, 'a');
+            if (position < size)
+            {
+                data[position] = '\r';
+            }
+            if (position + 1 < size)
+            {
+                data[position + 1] = '\r';
+            }
+
+            const char * begin = data.c_str();
+            EXPECT_EQ(Priv::findByte(begin, begin + size, '\r'), begin + position) << size << ", " << position;
+        }
+    }
+}
+
+TEST(Priv_ByteScan, FindControl)
+{
+    const unsigned char controls[] = { 0x00, 0x09, 0x0D, 0x1F, 0x7F };
+
+    for (size_t size = 0; size < 100; size++)
+    {
+        for (size_t position = 0; position <= size; position++)
+        {
+            // Printable, obs-text and tab/space only matched depending on limit.
+            std::string data(size, '\0');
+            for (size_t i = 0; i < size; i++)
+            {
+                data[i] = static_cast<char>((i % 3 == 0) ? 'x' : ((i % 3 == 1) ? 0x80 : 0xFF));
+            }
+
+            const char * begin = data.c_str();
+            EXPECT_EQ(Priv::findControl(begin, begin + size, 0x20), begin + size);
+
+            if (position < size)
+            {
+                data[position] = ' ';
+                EXPECT_EQ(Priv::findControl(begin, begin + size, 0x20), begin + position) << size << ", " << position;
+                EXPECT_EQ(Priv::findControl(begin, begin + size, 0x1F), begin + size) << size << ", " << position;
+
+                data[position] = static_cast<char>(controls[position % sizeof(controls)]);
+                EXPECT_EQ(Priv::findControl(begin, begin + size, 0x20), begin + position) << size << ", " << position;
+                EXPECT_EQ(Priv::findControl(begin, begin + size, 0x1F), begin + position) << size << ", " << position;
+            }
+        }
+    }
+}
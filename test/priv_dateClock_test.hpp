@@ -0,0 +1,79 @@
+#include "gtest/gtest.h"
+#include "wepp/priv/dateClock.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Wepp;
+
+namespace
+{
+    std::string formatDate(const std::time_t time)
+    {
+        char output[Priv::DateClock::dateSize];
+        Priv::DateClock::format(time, output);
+        return std::string(output, sizeof(output));
+    }
+}
+
+TEST(Priv_DateClock, Format)
+{
+    EXPECT_EQ(formatDate(0), "Thu, 01 Jan 1970 00:00:00 GMT");
+    EXPECT_EQ(formatDate(784111777), "Sun, 06 Nov 1994 08:49:37 GMT");
+    EXPECT_EQ(formatDate(951782400), "Tue, 29 Feb 2000 00:00:00 GMT");
+    EXPECT_EQ(formatDate(1546300799), "Mon, 31 Dec 2018 23:59:59 GMT");
+    EXPECT_EQ(formatDate(4102444800), "Fri, 01 Jan 2100 00:00:00 GMT");
+}
+
+TEST(Priv_DateClock, Copy)
+{
+    Priv::DateClock clock;
+    char output[Priv::DateClock::dateSize];
+
+    const std::time_t before = std::time(nullptr);
+    clock.copy(output);
+    const std::time_t after = std::time(nullptr);
+
+    const std::string date(output, sizeof(output));
+    EXPECT_TRUE(date == formatDate(before) || date == formatDate(after));
+}
+
+TEST(Priv_DateClock, ConcurrentCopy)
+{
+    const std::time_t start = std::time(nullptr);
+    Priv::DateClock clock;
+
+    // Copy while the date is rerendered, crossing at least one second.
+    std::vector<std::thread> threads;
+    std::atomic<size_t> torn(0);
+    for (size_t i = 0; i < 4; i++)
+    {
+        threads.push_back(std::thread([&clock, &torn, start]()
+        {
+            char output[Priv::DateClock::dateSize];
+            std::time_t now = start;
+            while (now < start + 2)
+            {
+                clock.copy(output);
+                now = std::time(nullptr);
+
+                const std::string date(output, sizeof(output));
+                bool valid = false;
+                for (std::time_t time = start; time <= now && !valid; time++)
+                {
+                    valid = date == formatDate(time);
+                }
+                if (!valid)
+                {
+                    torn++;
+                }
+            }
+        }));
+    }
+
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(torn.load(), size_t(0));
+}
@@ -26,7 +26,6 @@ TEST(Http_HttpReceiverBuffer, ReceiveString)
         const size_t bufferSize = 1024;
         Priv::HttpReceiverBuffer buffer(bufferSize);
         EXPECT_EQ(buffer.unreadBytes(), size_t(0));
-        std::string output = "";
 
         EXPECT_TRUE(buffer.receive("foo"));
         EXPECT_TRUE(buffer.receive(" bar"));
@@ -38,39 +37,29 @@ TEST(Http_HttpReceiverBuffer, ReceiveString)
 
         EXPECT_TRUE(buffer.receive("cool"));
 
-        EXPECT_EQ(buffer.readLine(output), Priv::HttpReceiverBuffer::FindResult::Found);
-        EXPECT_STREQ(output.c_str(), "foo bar");
-
-        EXPECT_EQ(buffer.readLine(output), Priv::HttpReceiverBuffer::FindResult::Found);
-        EXPECT_STREQ(output.c_str(), "hello world");
-
-        EXPECT_EQ(buffer.readLine(output), Priv::HttpReceiverBuffer::FindResult::NewlineNotFound);
+        EXPECT_EQ(std::string(buffer.unreadData(), buffer.unreadBytes()), "foo bar\r\nhello world\r\ncool");
     }
 }
 
-TEST(Http_HttpReceiverBuffer, Newline)
+TEST(Http_HttpReceiverBuffer, Consume)
 {
    {
         const size_t bufferSize = 1024;
         Priv::HttpReceiverBuffer buffer(bufferSize);
         EXPECT_EQ(buffer.unreadBytes(), size_t(0));
-        std::string output = "";
         
         EXPECT_TRUE(buffer.receive("foo"));
         EXPECT_EQ(buffer.unreadBytes(), size_t(3));
         EXPECT_TRUE(buffer.receive(" bar"));
         EXPECT_EQ(buffer.unreadBytes(), size_t(7));
-        
-        EXPECT_EQ(buffer.readLine(output), Priv::HttpReceiverBuffer::FindResult::NewlineNotFound);
-        EXPECT_EQ(buffer.unreadBytes(), size_t(7));
-        EXPECT_STRNE(output.c_str(), "foo bar");
 
-        EXPECT_TRUE(buffer.receive("\r\n"));
-        EXPECT_EQ(buffer.unreadBytes(), size_t(9));
+        buffer.consume(4);
+        EXPECT_EQ(buffer.unreadBytes(), size_t(3));
+        EXPECT_EQ(std::string(buffer.unreadData(), buffer.unreadBytes()), "bar");
 
-        EXPECT_EQ(buffer.readLine(output), Priv::HttpReceiverBuffer::FindResult::Found);
+        // Consuming is limited to the unread bytes.
+        buffer.consume(10);
         EXPECT_EQ(buffer.unreadBytes(), size_t(0));
-        EXPECT_STREQ(output.c_str(), "foo bar");
     }
     {
         const size_t bufferSize = 1;
@@ -79,18 +68,6 @@ TEST(Http_HttpReceiverBuffer, Newline)
 
         EXPECT_FALSE(buffer.receive("\r\n"));
         EXPECT_EQ(buffer.unreadBytes(), size_t(0));
-        EXPECT_EQ(buffer.readNewline(), Priv::HttpReceiverBuffer::FindResult::NewlineNotFound);
-        EXPECT_EQ(buffer.unreadBytes(), size_t(0));
-    }
-    {
-        const size_t bufferSize = 2;
-        Priv::HttpReceiverBuffer buffer(bufferSize);
-        EXPECT_EQ(buffer.unreadBytes(), size_t(0));
-
-        EXPECT_TRUE(buffer.receive("\r\n"));
-        EXPECT_EQ(buffer.unreadBytes(), size_t(2));
-        EXPECT_EQ(buffer.readNewline(), Priv::HttpReceiverBuffer::FindResult::Found);
-        EXPECT_EQ(buffer.unreadBytes(), size_t(0));
     }
     {
         const size_t bufferSize = 8;
@@ -108,15 +85,9 @@ TEST(Http_HttpReceiverBuffer, Newline)
         EXPECT_FALSE(buffer.receive("\r\n"));
         EXPECT_EQ(buffer.unreadBytes(), size_t(8));
 
-        EXPECT_EQ(buffer.readNewline(), Priv::HttpReceiverBuffer::FindResult::Found);
+        buffer.consume(2);
         EXPECT_EQ(buffer.unreadBytes(), size_t(6));
-        EXPECT_EQ(buffer.readNewline(), Priv::HttpReceiverBuffer::FindResult::Found);
-        EXPECT_EQ(buffer.unreadBytes(), size_t(4));
-        EXPECT_EQ(buffer.readNewline(), Priv::HttpReceiverBuffer::FindResult::Found);
-        EXPECT_EQ(buffer.unreadBytes(), size_t(2));
-        EXPECT_EQ(buffer.readNewline(), Priv::HttpReceiverBuffer::FindResult::Found);
-        EXPECT_EQ(buffer.unreadBytes(), size_t(0));
-        EXPECT_EQ(buffer.readNewline(), Priv::HttpReceiverBuffer::FindResult::NewlineNotFound);
+        buffer.reset();
         EXPECT_EQ(buffer.unreadBytes(), size_t(0));
     }
 }
@@ -129,30 +100,95 @@ TEST(Http_HttpReceiverBuffer, MakingSpace)
 
         const std::string firstString  = "First test string";
         const std::string secondString = "Second string is too long";
-        std::string output = "";
 
         EXPECT_TRUE(buffer.receive(firstString + "\r\n"));
         EXPECT_EQ(buffer.unreadBytes(), firstString.size() + 2);
+        EXPECT_EQ(std::string(buffer.unreadData(), buffer.unreadBytes()), firstString + "\r\n");
 
-        EXPECT_EQ(buffer.readLine(output), Priv::HttpReceiverBuffer::FindResult::Found);
+        buffer.consume(buffer.unreadBytes());
         EXPECT_EQ(buffer.unreadBytes(), size_t(0));
-        EXPECT_STREQ(output.c_str(), firstString.c_str());
 
+        // Fits only after the consumed bytes are reclaimed.
         EXPECT_TRUE(buffer.receive(secondString + "\r\n"));
         EXPECT_EQ(buffer.unreadBytes(), secondString.size() + 2);
+        EXPECT_EQ(std::string(buffer.unreadData(), buffer.unreadBytes()), secondString + "\r\n");
 
-        EXPECT_EQ(buffer.readLine(output), Priv::HttpReceiverBuffer::FindResult::Found);
+        buffer.consume(buffer.unreadBytes());
         EXPECT_EQ(buffer.unreadBytes(), size_t(0));
-        EXPECT_STREQ(output.c_str(), secondString.c_str());
     }
 }
 
 
-/*
-TEST(Http_HttpReceiverBuffer, RegexSearch)
+TEST(Http_HttpReceiver, Parse)
 {
+    auto onRequest = [](Http::Request &, Http::Response &) { return true; };
     {
+        // Resumed byte by byte.
+        const std::string data = "POST /foo HTTP/1.1\r\nHost: localhost\r\nContent-Length: 5\r\n\r\nhello";
+
+        Priv::HttpReceiverBuffer buffer(1024);
+        Priv::HttpReceiver receiver;
+        Http::Request request;
+        Http::Response response;
+
+        for (size_t i = 0; i < data.size() - 1; i++)
+        {
+            EXPECT_TRUE(buffer.receive(data.substr(i, 1)));
+            ASSERT_EQ(receiver.parse(buffer, request, response, onRequest), Priv::HttpReceiver::Status::NeedMore);
+        }
+        EXPECT_TRUE(buffer.receive(data.substr(data.size() - 1)));
+        ASSERT_EQ(receiver.parse(buffer, request, response, onRequest), Priv::HttpReceiver::Status::Ok);
+
+        EXPECT_EQ(request.method(), "POST");
+        EXPECT_EQ(request.resource(), "/foo");
+        EXPECT_EQ(request.header("host"), "localhost");
+        EXPECT_EQ(std::string(request.body().data(), request.body().size()), "hello");
+        EXPECT_EQ(buffer.unreadBytes(), size_t(0));
 
-
+        // Ready for next request.
+        Http::Request request2;
+        EXPECT_TRUE(buffer.receive("GET /bar HTTP/1.1\r\n\r\n"));
+        ASSERT_EQ(receiver.parse(buffer, request2, response, onRequest), Priv::HttpReceiver::Status::Ok);
+        EXPECT_EQ(request2.resource(), "/bar");
+    }
+    {
+        // Chunked body split in the middle of a chunk.
+        Priv::HttpReceiverBuffer buffer(1024);
+        Priv::HttpReceiver receiver;
+        Http::Request request;
+        Http::Response response;
+
+        EXPECT_TRUE(buffer.receive("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n5\r\nhel"));
+        ASSERT_EQ(receiver.parse(buffer, request, response, onRequest), Priv::HttpReceiver::Status::NeedMore);
+        EXPECT_TRUE(buffer.receive("lo\r\n0\r\n\r\n"));
+        ASSERT_EQ(receiver.parse(buffer, request, response, onRequest), Priv::HttpReceiver::Status::Ok);
+        EXPECT_EQ(std::string(request.body().data(), request.body().size()), "hello");
+    }
+    {
+        // The body of an expecting request is awaited after ExpectContinue.
+        Priv::HttpReceiverBuffer buffer(1024);
+        Priv::HttpReceiver receiver;
+        Http::Request request;
+        Http::Response response;
+
+        EXPECT_TRUE(buffer.receive("POST / HTTP/1.1\r\nContent-Length: 5\r\nExpect: 100-continue\r\n\r\n"));
+        ASSERT_EQ(receiver.parse(buffer, request, response, onRequest), Priv::HttpReceiver::Status::ExpectContinue);
+        ASSERT_EQ(receiver.parse(buffer, request, response, onRequest), Priv::HttpReceiver::Status::NeedMore);
+        EXPECT_TRUE(buffer.receive("hello"));
+        ASSERT_EQ(receiver.parse(buffer, request, response, onRequest), Priv::HttpReceiver::Status::Ok);
+        EXPECT_EQ(std::string(request.body().data(), request.body().size()), "hello");
     }
-}*/
\ No newline at end of file
+    {
+        // Header line filling the buffer.
+        Priv::HttpReceiverBuffer buffer(48);
+        Priv::HttpReceiver receiver;
+        Http::Request request;
+        Http::Response response;
+
+        EXPECT_TRUE(buffer.receive("GET / HTTP/1.1\r\nHost: " + std::string(26, 'x')));
+        ASSERT_EQ(receiver.parse(buffer, request, response, onRequest), Priv::HttpReceiver::Status::NeedMore);
+        EXPECT_TRUE(buffer.receive(std::string(16, 'x')));
+        ASSERT_EQ(receiver.parse(buffer, request, response, onRequest), Priv::HttpReceiver::Status::PeerError);
+        EXPECT_EQ(response.status(), Http::Status::RequestHeaderFieldsTooLarge);
+    }
+}
@@ -0,0 +1,50 @@
+#include "gtest/gtest.h"
+#include "wepp/priv/outputBuffer.hpp"
+#include "wepp/http/status.hpp"
+#include <string>
+
+using namespace Wepp;
+
+TEST(Priv_OutputBuffer, FormatInteger)
+{
+    const uint64_t values[] = { 0, 7, 10, 99, 100, 101, 999, 1000, 65535, 1234567890, 18446744073709551615ULL };
+    for (auto value : values)
+    {
+        char output[Priv::maxIntegerDigits];
+        const size_t length = Priv::formatInteger(value, output);
+        EXPECT_EQ(std::string(output, length), std::to_string(value));
+    }
+}
+
+TEST(Priv_OutputBuffer, Append)
+{
+    Priv::OutputBuffer output(4);
+    EXPECT_TRUE(output.empty());
+
+    output.append(StringView("Content-Length: "));
+    output.appendInteger(1024);
+    output.append("\r\n", 2);
+    EXPECT_EQ(std::string(output.data(), output.size()), "Content-Length: 1024\r\n");
+
+    const size_t capacity = output.capacity();
+    output.clear();
+    EXPECT_TRUE(output.empty());
+    EXPECT_EQ(output.capacity(), capacity);
+
+    output.append(std::string(1000, 'a'));
+    EXPECT_EQ(output.size(), size_t(1000));
+    output.shrink(16);
+    EXPECT_GE(output.capacity(), size_t(1000));
+    output.clear();
+    output.shrink(16);
+    EXPECT_EQ(output.capacity(), size_t(16));
+}
+
+TEST(Priv_OutputBuffer, StatusLine)
+{
+    EXPECT_EQ(Http::getStatusLine(Http::Status::Ok).str(), "HTTP/1.1 200 OK\r\n");
+    EXPECT_EQ(Http::getStatusLine(Http::Status::NotFound).str(), "HTTP/1.1 404 Not Found\r\n");
+    EXPECT_EQ(Http::getStatusLine(Http::Status::NetworkAuthenticationRequired).str(), "HTTP/1.1 511 Network Authentication Required\r\n");
+    EXPECT_EQ(Http::getStatusLine(static_cast<Http::Status>(299)).size(), size_t(0));
+    EXPECT_EQ(Http::getStatusAsString(Http::Status::ImATeapot), "I'm A Teapot");
+}
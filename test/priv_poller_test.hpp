@@ -0,0 +1,168 @@
+#include "gtest/gtest.h"
+#include "wepp/priv/poller.hpp"
+#include "wepp/socket/tcpAcceptor.hpp"
+#include <thread>
+#if defined(WEPP_PLATFORM_LINUX)
+#include <sys/resource.h>
+#endif
+
+using namespace Wepp;
+
+TEST(Priv_Poller, Accept)
+{
+    const unsigned short port = 54345;
+
+    {
+        Priv::Poller poller;
+        Socket::TcpAcceptor acceptor;
+        EXPECT_TRUE(acceptor.open(port));
+        EXPECT_FALSE(acceptor.open(port));
+        EXPECT_TRUE(poller.add(acceptor.handle(), &acceptor, false));
+        EXPECT_EQ(acceptor.accept(), nullptr);
+
+        std::vector<Priv::Poller::Event> events;
+        EXPECT_EQ(poller.wait(events, std::chrono::milliseconds(50)), size_t(0));
+
+        Socket::TcpSocket client;
+        EXPECT_TRUE(client.connect("127.0.0.1", port));
+
+        ASSERT_EQ(poller.wait(events, std::chrono::seconds(3)), size_t(1));
+        EXPECT_EQ(events[0].data, &acceptor);
+        EXPECT_TRUE(events[0].readable);
+
+        auto server = acceptor.accept();
+        ASSERT_NE(server, nullptr);
+        EXPECT_EQ(acceptor.accept(), nullptr);
+    }
+}
+
+#if defined(WEPP_PLATFORM_LINUX)
+TEST(Priv_Poller, AcceptOutOfDescriptors)
+{
+    const unsigned short port = 54345;
+
+    {
+        Priv::Poller poller;
+        Socket::TcpAcceptor acceptor;
+        EXPECT_TRUE(acceptor.open(port));
+        EXPECT_TRUE(poller.add(acceptor.handle(), &acceptor, false));
+
+        Socket::TcpSocket client;
+        EXPECT_TRUE(client.connect("127.0.0.1", port));
+
+        std::vector<Priv::Poller::Event> events;
+        ASSERT_EQ(poller.wait(events, std::chrono::seconds(3)), size_t(1));
+
+        // Exhaust the descriptors of the process.
+        rlimit limit;
+        ASSERT_EQ(getrlimit(RLIMIT_NOFILE, &limit), 0);
+        rlimit lowered = limit;
+        lowered.rlim_cur = 128;
+        ASSERT_EQ(setrlimit(RLIMIT_NOFILE, &lowered), 0);
+
+        std::vector<int> descriptors;
+        int descriptor = 0;
+        while ((descriptor = ::open("/dev/null", O_RDONLY)) >= 0)
+        {
+            descriptors.push_back(descriptor);
+        }
+
+        // The pending connection is shed instead of being left in the backlog.
+        Socket::TcpAcceptor::AcceptStatus status;
+        EXPECT_EQ(acceptor.accept(status), nullptr);
+        EXPECT_EQ(status, Socket::TcpAcceptor::AcceptStatus::OutOfDescriptors);
+        EXPECT_EQ(acceptor.accept(status), nullptr);
+        EXPECT_EQ(status, Socket::TcpAcceptor::AcceptStatus::WouldBlock);
+
+        for (auto d : descriptors)
+        {
+            ::close(d);
+        }
+        EXPECT_EQ(setrlimit(RLIMIT_NOFILE, &limit), 0);
+
+        char buffer[16];
+        EXPECT_LE(client.receive(buffer, sizeof(buffer)), 0);
+
+        Socket::TcpSocket client2;
+        EXPECT_TRUE(client2.connect("127.0.0.1", port));
+        ASSERT_EQ(poller.wait(events, std::chrono::seconds(3)), size_t(1));
+        EXPECT_NE(acceptor.accept(status), nullptr);
+        EXPECT_EQ(status, Socket::TcpAcceptor::AcceptStatus::Accepted);
+    }
+}
+#endif
+
+TEST(Priv_Poller, OneShot)
+{
+    const unsigned short port = 54345;
+
+    {
+        Priv::Poller poller;
+        Socket::TcpAcceptor acceptor;
+        EXPECT_TRUE(acceptor.open(port));
+
+        Socket::TcpSocket client;
+        EXPECT_TRUE(client.connect("127.0.0.1", port));
+        EXPECT_TRUE(acceptor.handle() != 0);
+
+        std::shared_ptr<Socket::TcpSocket> server;
+        for (size_t i = 0; i < 100 && server == nullptr; i++)
+        {
+            server = acceptor.accept();
+            if (server == nullptr)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+        ASSERT_NE(server, nullptr);
+
+        int data = 0;
+        EXPECT_TRUE(poller.add(server->handle(), &data, true));
+
+        std::vector<Priv::Poller::Event> events;
+        EXPECT_EQ(poller.wait(events, std::chrono::milliseconds(50)), size_t(0));
+
+        EXPECT_EQ(client.send("foo"), 3);
+        ASSERT_EQ(poller.wait(events, std::chrono::seconds(3)), size_t(1));
+        EXPECT_EQ(events[0].data, &data);
+        EXPECT_TRUE(events[0].readable);
+        EXPECT_FALSE(events[0].closed);
+
+        // Disabled until rearmed, even though data is still available.
+        EXPECT_EQ(client.send("bar"), 3);
+        EXPECT_EQ(poller.wait(events, std::chrono::milliseconds(50)), size_t(0));
+
+        EXPECT_TRUE(poller.rearm(server->handle(), &data));
+        ASSERT_EQ(poller.wait(events, std::chrono::seconds(3)), size_t(1));
+        EXPECT_EQ(events[0].data, &data);
+
+        char buffer[16];
+        EXPECT_EQ(server->receive(buffer, sizeof(buffer)), 6);
+        EXPECT_EQ(server->receive(buffer, sizeof(buffer)), -1);
+        EXPECT_TRUE(Socket::Socket::wouldBlock());
+
+        EXPECT_TRUE(poller.remove(server->handle()));
+        EXPECT_FALSE(poller.remove(server->handle()));
+    }
+}
+
+TEST(Priv_Poller, Interrupt)
+{
+    {
+        Priv::Poller poller;
+        std::vector<Priv::Poller::Event> events;
+
+        std::thread thread([&poller]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            poller.interrupt();
+        });
+
+        auto start = std::chrono::steady_clock::now();
+        EXPECT_EQ(poller.wait(events, std::chrono::seconds(10)), size_t(0));
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        EXPECT_LT(elapsed.count(), 5.0);
+
+        thread.join();
+    }
+}
@@ -0,0 +1,39 @@
+#include "gtest/gtest.h"
+#include "wepp/priv/routeScan.hpp"
+#include <string>
+
+using namespace Wepp;
+
+TEST(Priv_RoutePattern, Match)
+{
+    Http::RouteCaptures captures;
+
+    const Priv::RoutePattern pattern("/a/<x:int>-<y:slug>.txt");
+    EXPECT_FALSE(pattern.valid());
+    EXPECT_FALSE(Priv::RoutePattern().valid());
+    EXPECT_FALSE(Priv::RoutePattern("/a/<x:int").valid());
+
+    const Priv::RoutePattern literal("/a/b");
+    EXPECT_TRUE(literal.valid());
+    EXPECT_TRUE(literal.match("/a/b", captures));
+    EXPECT_TRUE(literal.match("a/b", captures));
+    EXPECT_FALSE(literal.match("/a/b/", captures));
+    EXPECT_FALSE(literal.match("/a/", captures));
+
+    const Priv::RoutePattern tagged("/user/<id:int>.json/<rest:path*>");
+    EXPECT_TRUE(tagged.valid());
+    ASSERT_TRUE(tagged.match("/user/12.json/x/y", captures));
+    ASSERT_EQ(captures.size(), size_t(2));
+    EXPECT_EQ(captures.integer("id"), int64_t(12));
+    EXPECT_EQ(captures.value("rest"), StringView("x/y"));
+    EXPECT_FALSE(tagged.match("/user/12.xml/x", captures));
+    EXPECT_TRUE(captures.empty());
+
+    // Patterns with more tags than captures never match.
+    std::string many;
+    for (size_t i = 0; i <= Http::RouteCaptures::capacity; i++)
+    {
+        many += "/<>";
+    }
+    EXPECT_FALSE(Priv::RoutePattern(many.c_str()).valid());
+}
@@ -76,3 +76,29 @@ TEST(TcpListener, Listen)
 
 }
 
+
+TEST(TcpListener, SendGather)
+{
+    const unsigned short port = 54344;
+
+    Socket::TcpListener listener;
+    EXPECT_TRUE(listener.start(port).wait().successful());
+
+    auto listenTask = listener.listen();
+    Socket::TcpSocket client;
+    ASSERT_TRUE(client.connect("127.0.0.1", port));
+    ASSERT_TRUE(listenTask.wait(std::chrono::seconds(3)).successful());
+    auto server = listenTask();
+
+    const Socket::SendBuffer buffers[] = { { "Hello", 5 }, { nullptr, 0 }, { " gather", 7 }, { " world!", 7 } };
+    EXPECT_EQ(server->sendv(buffers, 4), 19);
+
+    std::string received;
+    char buffer[64];
+    int size = 0;
+    while (received.size() < 19 && (size = client.receive(buffer, sizeof(buffer))) > 0)
+    {
+        received.append(buffer, static_cast<size_t>(size));
+    }
+    EXPECT_EQ(received, "Hello gather world!");
+}
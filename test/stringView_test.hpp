@@ -0,0 +1,46 @@
+#include "gtest/gtest.h"
+#include "wepp/stringView.hpp"
+
+using namespace Wepp;
+
+TEST(StringView, StringView)
+{
+    {
+        StringView view;
+        EXPECT_TRUE(view.empty());
+        EXPECT_EQ(view.size(), size_t(0));
+        EXPECT_EQ(view, "");
+        EXPECT_EQ(view.str(), "");
+    }
+    {
+        const std::string string = "Hello world";
+        StringView view(string);
+        EXPECT_EQ(view.data(), string.data());
+        EXPECT_EQ(view.size(), size_t(11));
+        EXPECT_EQ(view, "Hello world");
+        EXPECT_EQ(view, string);
+        EXPECT_NE(view, "Hello worl");
+        EXPECT_EQ(view[4], 'o');
+        EXPECT_EQ(std::string(view.begin(), view.end()), string);
+
+        EXPECT_EQ(view.substr(6), "world");
+        EXPECT_EQ(view.substr(0, 5), "Hello");
+        EXPECT_EQ(view.substr(20), "");
+        EXPECT_EQ(view.substr(6, 100), "world");
+
+        EXPECT_EQ(view.find('o'), size_t(4));
+        EXPECT_EQ(view.find('o', 5), size_t(7));
+        EXPECT_EQ(view.find('x'), StringView::npos);
+        EXPECT_EQ(view.find('H', 20), StringView::npos);
+
+        EXPECT_TRUE(view.equalsIgnoreCase("hELLO WORLD"));
+        EXPECT_FALSE(view.equalsIgnoreCase("hello"));
+        EXPECT_FALSE(view.equalsIgnoreCase("hello_world"));
+    }
+    {
+        EXPECT_TRUE(StringView("abc") < StringView("abd"));
+        EXPECT_TRUE(StringView("ab") < StringView("abc"));
+        EXPECT_FALSE(StringView("abc") < StringView("abc"));
+        EXPECT_EQ(StringView("abcdef", 3), "abc");
+    }
+}
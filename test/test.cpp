@@ -1,15 +1,27 @@
 #include "gtest/gtest.h"
 
 #include "uri_test.hpp"
+#include "stringView_test.hpp"
 #include "task_test.hpp"
 #include "socket_socket_test.hpp"
 #include "socket_tcp_socket_listener_test.hpp"
 #include "http_method_test.hpp"
 #include "http_router_test.hpp"
+#include "http_static_router_test.hpp"
 #include "http_request_test.hpp"
 #include "http_response_test.hpp"
+#include "http_body_test.hpp"
+#include "http_headerMap_test.hpp"
+#include "http_httpParser_test.hpp"
+#include "http_chunkedDecoder_test.hpp"
 #include "priv_threadPool_test.hpp"
 #include "priv_httpReceiver_test.hpp"
+#include "priv_byteScan_test.hpp"
+#include "priv_outputBuffer_test.hpp"
+#include "priv_dateClock_test.hpp"
+#include "priv_routeScan_test.hpp"
+#include "priv_poller_test.hpp"
+#include "http_server_connection_test.hpp"
 //#include "http_server_test.hpp"
 
 int main(int argc, char ** argv)